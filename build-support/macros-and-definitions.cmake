@@ -925,6 +925,16 @@ macro(process_options)
     endif()
   endif()
 
+  if(${NS3_MTP})
+    # Reference counts and packet buffers become thread-safe
+    add_definitions(-DNS3_MTP)
+  endif()
+
+  if(${NS3_ELIDE_HOT_TRACES})
+    # TracedValuePolicy::Hot trace sources become plain values
+    add_definitions(-DNS3_ELIDE_HOT_TRACES)
+  endif()
+
   mark_as_advanced(Boost_INCLUDE_DIR)
   find_package(Boost)
   if(${Boost_FOUND})
@@ -1238,6 +1248,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${NS3_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
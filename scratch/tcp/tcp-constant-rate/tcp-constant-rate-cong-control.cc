@@ -38,20 +38,20 @@ TypeId
 TcpConstantRate::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::TcpConstantRate")
-                            .SetParent<TcpCongestionOpsCustom>()
+                            .SetParent<TcpCongestionOps>()
                             .SetGroupName("Internet")
                             .AddConstructor<TcpConstantRate>();
     return tid;
 }
 
 TcpConstantRate::TcpConstantRate()
-    : TcpCongestionOpsCustom(), mi(MonitorInterval(sending_rate, Time("5s")))
+    : TcpCongestionOps(), mi(MonitorInterval(sending_rate, Time("5s")))
 {
     NS_LOG_FUNCTION(this);
 }
 
 TcpConstantRate::TcpConstantRate(const TcpConstantRate& sock)
-    : TcpCongestionOpsCustom(sock), mi(MonitorInterval(sending_rate, Time("5s")))
+    : TcpCongestionOps(sock), mi(MonitorInterval(sending_rate, Time("5s")))
 {
     NS_LOG_FUNCTION(this);
 }
@@ -158,18 +158,21 @@ TcpConstantRate::CongControl(Ptr<TcpSocketState> tcb,
 }
 
 void
-TcpConstantRate::ProcessECN()
+TcpConstantRate::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt)
 {
-    std::cout << "Here is ProcessECN\n";
 }
 
-void
-TcpConstantRate::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt)
+bool
+TcpConstantRate::HasPacketEvents() const
 {
+    return true;
 }
 
 void
-TcpConstantRate::OnPacketSent(Ptr<TcpSocketState> tcb, SequenceNumber32 seq, uint32_t sz)
+TcpConstantRate::OnPacketSent(Ptr<TcpSocketState> tcb,
+                              SequenceNumber32 seq,
+                              uint32_t sz,
+                              const Time& sentTime)
 {
     auto current_time = Simulator::Now();
     // Update socket sending rate once
@@ -183,14 +186,17 @@ TcpConstantRate::OnPacketSent(Ptr<TcpSocketState> tcb, SequenceNumber32 seq, uin
 }
 
 void
-TcpConstantRate::OnPacketLost(SequenceNumber32 seq, uint32_t sz)
+TcpConstantRate::OnPacketLost(Ptr<TcpSocketState> tcb,
+                              SequenceNumber32 seq,
+                              uint32_t sz,
+                              const Time& sentTime)
 {
     auto current_time = Simulator::Now();
     mi.OnPacketLost(current_time, seq, sz);
     // std::cout << "Here is PacketLoss " << seq << " "<< sz << "\n";
 }
 
-Ptr<TcpCongestionOpsCustom>
+Ptr<TcpCongestionOps>
 TcpConstantRate::Fork()
 {
     return CopyObject<TcpConstantRate>(this);
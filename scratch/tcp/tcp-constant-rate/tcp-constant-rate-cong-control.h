@@ -18,7 +18,7 @@
 // #ifndef TCPCONGESTIONOPS_CUSTOM_H
 // #define TCPCONGESTIONOPS_CUSTOM_H
 
-#include "tcp-congestion-ops-custom.h"
+#include "ns3/tcp-congestion-ops.h"
 #include "ns3/tcp-socket-base.h"
 #include "ns3/data-rate.h"
 #include "ns3/random-variable-stream.h"
@@ -36,7 +36,7 @@ namespace ns3
  * It configures the rate to be constant.
  *
  */
-class TcpConstantRate : public TcpCongestionOpsCustom
+class TcpConstantRate : public TcpCongestionOps
 {
   public:
     /**
@@ -60,16 +60,22 @@ class TcpConstantRate : public TcpCongestionOpsCustom
     void CongestionStateSet(Ptr<TcpSocketState> tcb, const TcpSocketState::TcpCongState_t newState) override;
     // void IncreaseWindow(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked) override;
     uint32_t GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight) override;
-    Ptr<TcpCongestionOpsCustom> Fork() override;
+    Ptr<TcpCongestionOps> Fork() override;
     bool HasCongControl() const override;
     void CongControl(Ptr<TcpSocketState> tcb,
                      const TcpRateOps::TcpRateConnection& rc,
                      const TcpRateOps::TcpRateSample& rs) override;
-    void ProcessECN();
 
     void PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt);
-    void OnPacketSent(Ptr<TcpSocketState> tcb, SequenceNumber32 seq, uint32_t sz);
-    void OnPacketLost(SequenceNumber32 seq, uint32_t sz);
+    bool HasPacketEvents() const override;
+    void OnPacketSent(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t sz,
+                      const Time& sentTime) override;
+    void OnPacketLost(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t sz,
+                      const Time& sentTime) override;
 
   protected:
 
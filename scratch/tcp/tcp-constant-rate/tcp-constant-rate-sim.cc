@@ -67,11 +67,11 @@ SsThreshTracer(uint32_t oldval, uint32_t newval)
 void
 ConnectSocketTraces()
 {
-    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketList/0/CongestionWindow",
+    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4Protocol/SocketList/0/CongestionWindow",
                                   MakeCallback(&CwndTracer));
-    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketList/0/PacingRate",
+    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4Protocol/SocketList/0/PacingRate",
                                   MakeCallback(&PacingRateTracer));
-    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketList/0/SlowStartThreshold",
+    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4Protocol/SocketList/0/SlowStartThreshold",
                                   MakeCallback(&SsThreshTracer));
 }
 
@@ -138,10 +138,7 @@ main(int argc, char* argv[])
     internet.Install(dumbell.GetRight());
     internet.Install(dumbell.GetLeft());
     internet.Install(dumbell.GetRight(0));
-
-    InternetStackHelper internetCustomL4;
-    internetCustomL4.SetTcp("ns3::TcpL4ProtocolCustom");
-    internetCustomL4.Install(dumbell.GetLeft(0));
+    internet.Install(dumbell.GetLeft(0));
 
     //
     // We've got the "hardware" in place.  Now we need to add IP addresses.
@@ -160,7 +157,7 @@ main(int argc, char* argv[])
     uint16_t port = 1337; // well-known echo port number
 
     BulkSendHelper source("ns3::TcpSocketFactory", InetSocketAddress(dumbell.GetRightIpv4Address(0), port));
-    Config::Set("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketType", StringValue("ns3::TcpConstantRate"));
+    Config::Set("/NodeList/4/$ns3::TcpL4Protocol/SocketType", StringValue("ns3::TcpConstantRate"));
     // Set the amount of data to send in bytes.  Zero is unlimited.
     source.SetAttribute("MaxBytes", UintegerValue(maxBytes));
     ApplicationContainer sourceApps = source.Install(dumbell.GetLeft(0));
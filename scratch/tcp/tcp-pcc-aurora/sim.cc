@@ -71,11 +71,11 @@ SsThreshTracer(uint32_t oldval, uint32_t newval)
 void
 ConnectSocketTraces()
 {
-    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketList/0/CongestionWindow",
+    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4Protocol/SocketList/0/CongestionWindow",
                                   MakeCallback(&CwndTracer));
-    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketList/0/PacingRate",
+    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4Protocol/SocketList/0/PacingRate",
                                   MakeCallback(&PacingRateTracer));
-    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketList/0/SlowStartThreshold",
+    Config::ConnectWithoutContext("/NodeList/4/$ns3::TcpL4Protocol/SocketList/0/SlowStartThreshold",
                                   MakeCallback(&SsThreshTracer));
 }
 
@@ -140,7 +140,7 @@ main(int argc, char* argv[])
     LogComponentEnableAll (LOG_PREFIX_NODE);
     // LogComponentEnable("BulkSendApplication", LOG_LEVEL_INFO);
     // LogComponentEnable("TcpPccAurora", LOG_LEVEL_INFO);
-    // LogComponentEnable("TcpSocketBaseCustom", LOG_LEVEL_INFO);
+    // LogComponentEnable("TcpSocketBase", LOG_LEVEL_INFO);
 
     // Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpNewReno"));
     // ConfigStore config;
@@ -183,10 +183,7 @@ main(int argc, char* argv[])
     internet.Install(dumbell.GetRight());
     internet.Install(dumbell.GetLeft());
     internet.Install(dumbell.GetRight(0));
-
-    InternetStackHelper internetCustomL4;
-    internetCustomL4.SetTcp("ns3::TcpL4ProtocolCustom");
-    internetCustomL4.Install(dumbell.GetLeft(0));
+    internet.Install(dumbell.GetLeft(0));
 
     //
     // We've got the "hardware" in place.  Now we need to add IP addresses.
@@ -205,7 +202,7 @@ main(int argc, char* argv[])
     uint16_t port = 1337; // well-known echo port number
 
     BulkSendHelper source("ns3::TcpSocketFactory", InetSocketAddress(dumbell.GetRightIpv4Address(0), port));
-    Config::Set("/NodeList/4/$ns3::TcpL4ProtocolCustom/SocketType", StringValue("ns3::TcpPccAurora"));
+    Config::Set("/NodeList/4/$ns3::TcpL4Protocol/SocketType", StringValue("ns3::TcpPccAurora"));
     Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(2500000));
     Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(5000000));
     Config::SetDefault("ns3::TcpSocket::DelAckCount", UintegerValue(2));
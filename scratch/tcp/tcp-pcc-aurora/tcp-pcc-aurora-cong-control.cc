@@ -77,14 +77,14 @@ TypeId
 TcpPccAurora::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::TcpPccAurora")
-                            .SetParent<TcpCongestionOpsCustom>()
+                            .SetParent<TcpCongestionOps>()
                             .SetGroupName("Internet")
                             .AddConstructor<TcpPccAurora>();
     return tid;
 }
 
 TcpPccAurora::TcpPccAurora()
-    : TcpCongestionOpsCustom()
+    : TcpCongestionOps()
 {
     NS_LOG_FUNCTION(this);
     // std::cout << "Starting sending rate = " << m_sending_rate << std::endl;
@@ -93,7 +93,7 @@ TcpPccAurora::TcpPccAurora()
 }
 
 TcpPccAurora::TcpPccAurora(const TcpPccAurora& sock)
-    : TcpCongestionOpsCustom(sock)
+    : TcpCongestionOps(sock)
 {
     NS_LOG_FUNCTION(this);
     // std::cout << "Starting sending rate = " << m_sending_rate << std::endl;
@@ -210,18 +210,21 @@ TcpPccAurora::CongControl(Ptr<TcpSocketState> tcb,
 }
 
 void
-TcpPccAurora::ProcessECN()
+TcpPccAurora::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt)
 {
-    std::cout << "Here is ProcessECN\n";
 }
 
-void
-TcpPccAurora::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt)
+bool
+TcpPccAurora::HasPacketEvents() const
 {
+    return true;
 }
 
 void
-TcpPccAurora::OnPacketSent(Ptr<TcpSocketState> tcb, SequenceNumber32 seq, uint32_t sz)
+TcpPccAurora::OnPacketSent(Ptr<TcpSocketState> tcb,
+                           SequenceNumber32 seq,
+                           uint32_t sz,
+                           const Time& sentTime)
 {
     if (m_wait_mode) return;
     auto sent_time = Simulator::Now();
@@ -243,7 +246,10 @@ TcpPccAurora::OnPacketSent(Ptr<TcpSocketState> tcb, SequenceNumber32 seq, uint32
 }
 
 void
-TcpPccAurora::OnPacketLost(SequenceNumber32 seq, uint32_t sz)
+TcpPccAurora::OnPacketLost(Ptr<TcpSocketState> tcb,
+                           SequenceNumber32 seq,
+                           uint32_t sz,
+                           const Time& sentTime)
 {
     auto event_time = Simulator::Now();
     m_interval_queue.OnPacketLost(event_time, seq, sz);
@@ -296,7 +302,7 @@ Time TcpPccAurora::ComputeMonitorDuration(
                Time("1s").GetDouble()));
 }
 
-Ptr<TcpCongestionOpsCustom>
+Ptr<TcpCongestionOps>
 TcpPccAurora::Fork()
 {
     return CopyObject<TcpPccAurora>(this);
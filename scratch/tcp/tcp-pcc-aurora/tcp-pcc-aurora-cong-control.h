@@ -20,7 +20,7 @@
 
 #include <mutex>
 
-#include "tcp-congestion-ops-custom.h"
+#include "ns3/tcp-congestion-ops.h"
 #include "ns3/tcp-socket-base.h"
 #include "ns3/data-rate.h"
 #include "ns3/random-variable-stream.h"
@@ -56,7 +56,7 @@ class RttEstimatorJK
  * It configures the rate to be constant.
  *
  */
-class TcpPccAurora : public TcpCongestionOpsCustom
+class TcpPccAurora : public TcpCongestionOps
 {
   public:
     /**
@@ -80,16 +80,22 @@ class TcpPccAurora : public TcpCongestionOpsCustom
     void CongestionStateSet(Ptr<TcpSocketState> tcb, const TcpSocketState::TcpCongState_t newState) override;
     // void IncreaseWindow(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked) override;
     uint32_t GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight) override;
-    Ptr<TcpCongestionOpsCustom> Fork() override;
+    Ptr<TcpCongestionOps> Fork() override;
     bool HasCongControl() const override;
     void CongControl(Ptr<TcpSocketState> tcb,
                      const TcpRateOps::TcpRateConnection& rc,
                      const TcpRateOps::TcpRateSample& rs) override;
-    void ProcessECN();
 
     void PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt);
-    void OnPacketSent(Ptr<TcpSocketState> tcb, SequenceNumber32 seq, uint32_t sz);
-    void OnPacketLost(SequenceNumber32 seq, uint32_t sz);
+    bool HasPacketEvents() const override;
+    void OnPacketSent(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t sz,
+                      const Time& sentTime) override;
+    void OnPacketLost(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t sz,
+                      const Time& sentTime) override;
 
   protected:
 
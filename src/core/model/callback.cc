@@ -32,6 +32,16 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Callback");
 
+bool
+CallbackBase::DoIsEqual(const CallbackBase& other) const
+{
+    if (m_ops != nullptr && m_ops == other.m_ops)
+    {
+        return m_ops->m_isEqual(m_storage, other.m_storage);
+    }
+    return GetImpl()->IsEqual(other.GetImpl());
+}
+
 CallbackValue::CallbackValue()
     : m_value()
 {
@@ -29,6 +29,8 @@
 
 #include <functional>
 #include <memory>
+#include <new>
+#include <tuple>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -356,23 +358,128 @@ class CallbackImpl : public CallbackImplBase
     std::vector<std::shared_ptr<CallbackComponentBase>> m_components;
 };
 
+/**
+ * \ingroup callbackimpl
+ * Operations on a callable object and its bound arguments stored inline
+ * in a CallbackBase, instead of in a CallbackImpl.
+ *
+ * There is a single instance of this structure for each type of callback,
+ * callable object and bound arguments, so two inline callbacks with the
+ * same operations store the same types.
+ */
+struct CallbackInlineOps
+{
+    void (*m_copy)(void* dst, const void* src);        //!< Copy construct dst from src
+    void (*m_move)(void* dst, void* src);              //!< Move construct dst from src, destroy src
+    void (*m_destroy)(void* storage);                  //!< Destroy the stored values
+    bool (*m_isEqual)(const void* a, const void* b);   //!< Compare the stored values
+    Ptr<CallbackImplBase> (*m_getImpl)(const void* s); //!< Build the equivalent CallbackImpl
+    std::string (*m_getTypeid)();                      //!< Name of the CallbackImpl type
+    const std::type_info* m_signature;                 //!< Type of the equivalent CallbackImpl
+    void (*m_invoke)();                                //!< Call the stored function (type-erased)
+};
+
 /**
  * \ingroup callbackimpl
  * Base class for Callback class.
  * Provides pimpl abstraction.
+ *
+ * A function or member function whose bound arguments fit in
+ * INLINE_SIZE bytes is stored inline, so building, copying and
+ * destroying the callback does not allocate memory. Any other callable
+ * object is stored in a reference counted CallbackImpl.
  */
 class CallbackBase
 {
   public:
     CallbackBase()
-        : m_impl()
+        : m_impl(),
+          m_ops(nullptr)
     {
     }
 
-    /** \return The impl pointer */
+    /**
+     * Copy constructor.
+     * \param [in] o The callback to copy.
+     */
+    CallbackBase(const CallbackBase& o)
+        : m_impl(o.m_impl),
+          m_ops(o.m_ops)
+    {
+        if (m_ops != nullptr)
+        {
+            m_ops->m_copy(m_storage, o.m_storage);
+        }
+    }
+
+    /**
+     * Move constructor.
+     * \param [in] o The callback to move; it becomes null.
+     */
+    CallbackBase(CallbackBase&& o) noexcept
+        : m_impl(o.m_impl),
+          m_ops(o.m_ops)
+    {
+        if (m_ops != nullptr)
+        {
+            m_ops->m_move(m_storage, o.m_storage);
+            o.m_ops = nullptr;
+        }
+        o.m_impl = nullptr;
+    }
+
+    /**
+     * Copy assignment.
+     * \param [in] o The callback to copy.
+     * \returns This callback.
+     */
+    CallbackBase& operator=(const CallbackBase& o)
+    {
+        if (this != &o)
+        {
+            // copy first, in case o is owned by an object bound to this callback
+            CallbackBase copy(o);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    /**
+     * Move assignment.
+     * \param [in] o The callback to move; it becomes null.
+     * \returns This callback.
+     */
+    CallbackBase& operator=(CallbackBase&& o) noexcept
+    {
+        if (this != &o)
+        {
+            Reset();
+            m_impl = o.m_impl;
+            o.m_impl = nullptr;
+            if (o.m_ops != nullptr)
+            {
+                o.m_ops->m_move(m_storage, o.m_storage);
+                m_ops = o.m_ops;
+                o.m_ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~CallbackBase()
+    {
+        Reset();
+    }
+
+    /**
+     * Get the implementation of this callback. For a callback stored
+     * inline, this builds a new equivalent CallbackImpl.
+     *
+     * \return The impl pointer
+     */
     Ptr<CallbackImplBase> GetImpl() const
     {
-        return m_impl;
+        return m_ops != nullptr ? m_ops->m_getImpl(m_storage) : m_impl;
     }
 
   protected:
@@ -381,11 +488,39 @@ class CallbackBase
      * \param [in] impl The CallbackImplBase Ptr
      */
     CallbackBase(Ptr<CallbackImplBase> impl)
-        : m_impl(impl)
+        : m_impl(impl),
+          m_ops(nullptr)
     {
     }
 
-    Ptr<CallbackImplBase> m_impl; //!< the pimpl
+    /** Discard the implementation, set it to null */
+    void Reset()
+    {
+        if (m_ops != nullptr)
+        {
+            m_ops->m_destroy(m_storage);
+            m_ops = nullptr;
+        }
+        m_impl = nullptr;
+    }
+
+    /**
+     * Equality test.
+     *
+     * \param [in] other Callback
+     * \return \c true if we are equal
+     */
+    bool DoIsEqual(const CallbackBase& other) const;
+
+    /** Size of the inline storage, in bytes. */
+    static constexpr std::size_t INLINE_SIZE = 4 * sizeof(void*);
+
+    Ptr<CallbackImplBase> m_impl;                        //!< the pimpl
+    const CallbackInlineOps* m_ops;                      //!< the inline operations, if inline
+    alignas(void*) unsigned char m_storage[INLINE_SIZE]; //!< the inline storage
+
+    template <typename R, typename... UArgs>
+    friend class Callback;
 };
 
 /**
@@ -422,7 +557,8 @@ class CallbackBase
  *     is smaller than the maximum supported number
  *   - the pimpl idiom: the Callback class is passed around by
  *     value and delegates the crux of the work to its pimpl
- *     pointer.
+ *     pointer, except for the functions and member functions with
+ *     a few bound arguments, which are stored inline.
  *   - a reference list implementation to implement the Callback's
  *     value semantics.
  *
@@ -466,8 +602,8 @@ class Callback : public CallbackBase
     template <typename... BArgs>
     Callback(const CallbackBase& cb, BArgs... bargs)
     {
-        auto cbDerived =
-            static_cast<const CallbackImpl<R, BArgs..., UArgs...>*>(PeekPointer(cb.GetImpl()));
+        Ptr<CallbackImplBase> impl = cb.GetImpl();
+        auto cbDerived = static_cast<const CallbackImpl<R, BArgs..., UArgs...>*>(PeekPointer(impl));
 
         std::function<R(BArgs..., UArgs...)> f(cbDerived->GetFunction());
 
@@ -495,6 +631,30 @@ class Callback : public CallbackBase
               std::enable_if_t<!std::is_base_of_v<CallbackBase, T>, int> = 0,
               typename... BArgs>
     Callback(T func, BArgs... bargs)
+    {
+        if constexpr (InlineCallback<T, BArgs...>::IS_INLINE)
+        {
+            new (m_storage) typename InlineCallback<T, BArgs...>::Storage(func, bargs...);
+            m_ops = InlineCallback<T, BArgs...>::GetOps();
+        }
+        else
+        {
+            m_impl = MakeImpl(func, bargs...);
+        }
+    }
+
+  private:
+    /**
+     * Build the CallbackImpl of a function and its bound arguments.
+     *
+     * \tparam T \deduced The type of the function
+     * \tparam BArgs \deduced The types of the bound arguments
+     * \param [in] func The function
+     * \param [in] bargs The values of the bound arguments
+     * \return The CallbackImpl
+     */
+    template <typename T, typename... BArgs>
+    static Ptr<CallbackImpl<R, UArgs...>> MakeImpl(T func, BArgs... bargs)
     {
         // store the function in a std::function object
         std::function<R(BArgs..., UArgs...)> f(func);
@@ -507,12 +667,126 @@ class Callback : public CallbackBase
         CallbackComponentVector components({std::make_shared<CallbackComponent<T, isComp>>(func),
                                             std::make_shared<CallbackComponent<BArgs>>(bargs)...});
 
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
+        return Create<CallbackImpl<R, UArgs...>>(
             [f, bargs...](UArgs... uargs) -> R { return f(bargs..., uargs...); },
             components);
     }
 
-  private:
+    /**
+     * The operations of a function and its bound arguments stored inline.
+     *
+     * \tparam T The type of the function
+     * \tparam BArgs The types of the bound arguments
+     */
+    template <typename T, typename... BArgs>
+    struct InlineCallback
+    {
+        /** The stored values: the function, then the bound arguments. */
+        typedef std::tuple<T, BArgs...> Storage;
+
+        /**
+         * Whether the function and its bound arguments are stored inline:
+         * only comparable functions are, so that the copies of a callback
+         * compare equal, as they do when they share a CallbackImpl.
+         */
+        static constexpr bool IS_INLINE =
+            (std::is_function_v<std::remove_pointer_t<T>> || std::is_member_pointer_v<T>) &&
+            sizeof(Storage) <= INLINE_SIZE && alignof(Storage) <= alignof(void*);
+
+        /** \copydoc CallbackInlineOps::m_copy */
+        static void Copy(void* dst, const void* src)
+        {
+            new (dst) Storage(*static_cast<const Storage*>(src));
+        }
+
+        /** \copydoc CallbackInlineOps::m_move */
+        static void Move(void* dst, void* src)
+        {
+            Storage* s = static_cast<Storage*>(src);
+            new (dst) Storage(std::move(*s));
+            s->~Storage();
+        }
+
+        /** \copydoc CallbackInlineOps::m_destroy */
+        static void Destroy(void* storage)
+        {
+            static_cast<Storage*>(storage)->~Storage();
+        }
+
+        /** \copydoc CallbackInlineOps::m_isEqual */
+        static bool IsEqual(const void* a, const void* b)
+        {
+            return IsEqual(*static_cast<const Storage*>(a),
+                           *static_cast<const Storage*>(b),
+                           std::index_sequence_for<T, BArgs...>{});
+        }
+
+        /**
+         * Compare the stored values one by one, as CallbackComponent does.
+         *
+         * \param [in] a The first stored values
+         * \param [in] b The second stored values
+         * \return \c true if the values are equal
+         */
+        template <std::size_t... INDEX>
+        static bool IsEqual(const Storage& a, const Storage& b, std::index_sequence<INDEX...>)
+        {
+            return (!(std::get<INDEX>(a) != std::get<INDEX>(b)) && ...);
+        }
+
+        /** \copydoc CallbackInlineOps::m_getImpl */
+        static Ptr<CallbackImplBase> GetImpl(const void* s)
+        {
+            return std::apply(&MakeImpl<T, BArgs...>, *static_cast<const Storage*>(s));
+        }
+
+        /**
+         * Call the stored function.
+         *
+         * The bound arguments are passed by value, as CallbackImpl does, so
+         * that they live until the call returns even if the callback is
+         * destroyed during the call (e.g., a Ptr to the object whose
+         * member function is called).
+         *
+         * \param [in] storage The stored values
+         * \param [in] uargs The arguments to the callback
+         * \return Callback value
+         */
+        static R Invoke(const void* storage, UArgs... uargs)
+        {
+            return std::apply(
+                [&uargs...](T func, BArgs... bargs) -> R {
+                    if constexpr (std::is_void_v<R>)
+                    {
+                        std::invoke(func, bargs..., uargs...);
+                    }
+                    else
+                    {
+                        return std::invoke(func, bargs..., uargs...);
+                    }
+                },
+                *static_cast<const Storage*>(storage));
+        }
+
+        /** \return The operations of this type of stored values */
+        static const CallbackInlineOps* GetOps()
+        {
+            static const CallbackInlineOps ops = {
+                &Copy,
+                &Move,
+                &Destroy,
+                &IsEqual,
+                &GetImpl,
+                &CallbackImpl<R, UArgs...>::DoGetTypeid,
+                &typeid(CallbackImpl<R, UArgs...>),
+                reinterpret_cast<void (*)()>(&Invoke)};
+            return &ops;
+        }
+    };
+
+    /** The type of the functions which call a callback stored inline. */
+    typedef R (*InlineInvoke)(const void*, UArgs...);
+
     /**
      * Implementation of the Bind method
      *
@@ -555,13 +829,13 @@ class Callback : public CallbackBase
      */
     bool IsNull() const
     {
-        return (DoPeekImpl() == nullptr);
+        return (m_ops == nullptr && DoPeekImpl() == nullptr);
     }
 
     /** Discard the implementation, set it to null */
     void Nullify()
     {
-        m_impl = nullptr;
+        Reset();
     }
 
     /**
@@ -572,6 +846,10 @@ class Callback : public CallbackBase
      */
     R operator()(UArgs... uargs) const
     {
+        if (m_ops != nullptr)
+        {
+            return reinterpret_cast<InlineInvoke>(m_ops->m_invoke)(m_storage, uargs...);
+        }
         return (*(DoPeekImpl()))(uargs...);
     }
 
@@ -583,7 +861,7 @@ class Callback : public CallbackBase
      */
     bool IsEqual(const CallbackBase& other) const
     {
-        return m_impl->IsEqual(other.GetImpl());
+        return DoIsEqual(other);
     }
 
     /**
@@ -594,7 +872,7 @@ class Callback : public CallbackBase
      */
     bool CheckType(const CallbackBase& other) const
     {
-        return DoCheckType(other.GetImpl());
+        return DoCheckType(other);
     }
 
     /**
@@ -605,10 +883,10 @@ class Callback : public CallbackBase
      */
     bool Assign(const CallbackBase& other)
     {
-        auto otherImpl = other.GetImpl();
-        if (!DoCheckType(otherImpl))
+        if (!DoCheckType(other))
         {
-            std::string othTid = otherImpl->GetTypeid();
+            std::string othTid =
+                other.m_ops != nullptr ? other.m_ops->m_getTypeid() : other.m_impl->GetTypeid();
             std::string myTid = CallbackImpl<R, UArgs...>::DoGetTypeid();
             NS_FATAL_ERROR_CONT("Incompatible types. (feed to \"c++filt -t\" if needed)"
                                 << std::endl
@@ -616,7 +894,7 @@ class Callback : public CallbackBase
                                 << "expected=" << myTid);
             return false;
         }
-        m_impl = const_cast<CallbackImplBase*>(PeekPointer(otherImpl));
+        CallbackBase::operator=(other);
         return true;
     }
 
@@ -630,11 +908,16 @@ class Callback : public CallbackBase
     /**
      * Check for compatible types
      *
-     * \param [in] other Callback Ptr
-     * \return \c true if other can be dynamic_cast to my type
+     * \param [in] cb Callback
+     * \return \c true if cb can be dynamic_cast to my type
      */
-    bool DoCheckType(Ptr<const CallbackImplBase> other) const
+    bool DoCheckType(const CallbackBase& cb) const
     {
+        if (cb.m_ops != nullptr)
+        {
+            return *cb.m_ops->m_signature == typeid(CallbackImpl<R, UArgs...>);
+        }
+        Ptr<const CallbackImplBase> other = cb.m_impl;
         if (other && dynamic_cast<const CallbackImpl<R, UArgs...>*>(PeekPointer(other)) != nullptr)
         {
             return true;
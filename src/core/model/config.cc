@@ -25,8 +25,11 @@
 #include "object.h"
 #include "pointer.h"
 #include "singleton.h"
+#include "trace-source-accessor.h"
 
+#include <algorithm>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * \file
@@ -1030,6 +1033,574 @@ GetRootNamespaceObject(uint32_t i)
     return ConfigImpl::Get()->GetRootNamespaceObject(i);
 }
 
+
+/**
+ * \ingroup config-impl
+ * The parsed path and the caches of a CompiledPath.
+ */
+class CompiledPath::Impl
+{
+  public:
+    /**
+     * Parse a path.
+     *
+     * \param [in] path The path.
+     */
+    Impl(std::string path);
+
+    /**
+     * Resolve the path without its leaf, from the registered root objects,
+     * then from the root of the "/Names" name space.
+     *
+     * \param [out] objects The matching objects.
+     * \param [out] contexts The contexts of the matching objects.
+     */
+    void Resolve(std::vector<Ptr<Object>>& objects, std::vector<std::string>& contexts);
+
+    /**
+     * Get the leaf trace source of an object.
+     *
+     * \param [in] object The object.
+     * \returns The trace source accessor, or null if the object has no
+     *          such trace source.
+     */
+    Ptr<const TraceSourceAccessor> GetTraceSource(Ptr<Object> object);
+
+    std::string m_path; //!< The path
+    std::string m_leaf; //!< The leaf of the path
+
+  private:
+    /** An attribute holding a pointer to an object or an object container. */
+    struct Attribute
+    {
+        std::string m_name;                          //!< The attribute name
+        Ptr<const AttributeAccessor> m_accessor;     //!< The attribute accessor
+        const ObjectPtrContainerAccessor* m_container; //!< The container accessor, or null
+    };
+
+    /** An element of the path, between two slashes. */
+    struct Token
+    {
+        std::string m_item;                                   //!< The element
+        bool m_isGetObject;                                   //!< The element is "$TypeId"
+        bool m_isTypeIdFound;                                 //!< The TypeId of "$TypeId" exists
+        TypeId m_tid;                                         //!< The TypeId of "$TypeId"
+        bool m_allIndices;                                    //!< The element matches any index
+        std::vector<std::pair<uint32_t, uint32_t>> m_indices; //!< The index ranges, sorted
+        /** The attributes matching the element, by TypeId uid of the object. */
+        std::unordered_map<uint16_t, std::vector<Attribute>> m_attributes;
+    };
+
+    /**
+     * Parse an index expression, as matched by ArrayMatcher.
+     *
+     * \param [in] element The index expression.
+     * \param [in,out] token The token receiving the index ranges.
+     */
+    static void ParseIndices(std::string element, Token& token);
+
+    /**
+     * Convert a string to an \c uint32_t, as ArrayMatcher does.
+     *
+     * \param [in] str The string.
+     * \param [out] value The value.
+     * \returns \c true if the string could be converted.
+     */
+    static bool StringToUint32(std::string str, uint32_t* value);
+
+    /**
+     * Test if an index matches an index expression.
+     *
+     * \param [in] token The token of the index expression.
+     * \param [in] index The index.
+     * \returns \c true if the index matches.
+     */
+    static bool Matches(const Token& token, std::size_t index);
+
+    /**
+     * Get the attributes of an object matching a token.
+     *
+     * \param [in] token The token.
+     * \param [in] tid The TypeId of the object.
+     * \returns The pointer and container attributes matching the token,
+     *          in the order of Resolver.
+     */
+    const std::vector<Attribute>& GetAttributes(Token& token, TypeId tid);
+
+    /**
+     * Resolve the path from an element.
+     *
+     * \param [in] i The index of the element.
+     * \param [in] root The object holding the element, or null at the root
+     *            of the "/Names" name space.
+     */
+    void DoResolve(std::size_t i, Ptr<Object> root);
+
+    /**
+     * Resolve an index element.
+     *
+     * \param [in] i The index of the element.
+     * \param [in] root The object holding the container.
+     * \param [in] attribute The container attribute.
+     */
+    void DoArrayResolve(std::size_t i, Ptr<Object> root, const Attribute& attribute);
+
+    /**
+     * Resolve the path from the next element, and restore the context.
+     *
+     * \param [in] i The index of the next element.
+     * \param [in] item The current element, appended to the context.
+     * \param [in] object The object of the current element.
+     */
+    void Descend(std::size_t i, const std::string& item, Ptr<Object> object);
+
+    std::vector<Token> m_tokens; //!< The elements of the path without its leaf
+    /** The trace sources of the leaf, by TypeId uid of the object. */
+    std::unordered_map<uint16_t, Ptr<const TraceSourceAccessor>> m_traceSources;
+
+    std::string m_context;                //!< The context of the current element
+    std::vector<Ptr<Object>>* m_objects;  //!< The matching objects
+    std::vector<std::string>* m_contexts; //!< The contexts of the matching objects
+};
+
+CompiledPath::Impl::Impl(std::string path)
+    : m_path(path),
+      m_objects(nullptr),
+      m_contexts(nullptr)
+{
+    NS_LOG_FUNCTION(this << path);
+    std::string::size_type slash = path.find_last_of('/');
+    NS_ASSERT(slash != std::string::npos);
+    std::string root = path.substr(0, slash);
+    m_leaf = path.substr(slash + 1);
+
+    // Canonicalize as Resolver does: start and end with a '/'
+    if (root.find('/') != 0)
+    {
+        root = "/" + root;
+    }
+    if (root.find_last_of('/') != root.size() - 1)
+    {
+        root += "/";
+    }
+
+    std::string::size_type pos = 0;
+    std::string::size_type next;
+    while ((next = root.find('/', pos + 1)) != std::string::npos)
+    {
+        Token token;
+        token.m_item = root.substr(pos + 1, next - (pos + 1));
+        token.m_isGetObject = token.m_item.find('$') == 0;
+        token.m_isTypeIdFound = false;
+        if (token.m_isGetObject)
+        {
+            // Report unknown TypeIds only if they are reached, as Resolver
+            token.m_isTypeIdFound = TypeId::LookupByNameFailSafe(token.m_item.substr(1),
+                                                                 &token.m_tid);
+        }
+        token.m_allIndices = false;
+        ParseIndices(token.m_item, token);
+        // Sort and merge the index ranges
+        std::sort(token.m_indices.begin(), token.m_indices.end());
+        std::vector<std::pair<uint32_t, uint32_t>> indices;
+        for (const auto& range : token.m_indices)
+        {
+            if (!indices.empty() && range.first <= indices.back().second)
+            {
+                indices.back().second = std::max(indices.back().second, range.second);
+            }
+            else
+            {
+                indices.push_back(range);
+            }
+        }
+        token.m_indices = indices;
+        m_tokens.push_back(token);
+        pos = next;
+    }
+}
+
+void
+CompiledPath::Impl::ParseIndices(std::string element, Token& token)
+{
+    if (element == "*")
+    {
+        token.m_allIndices = true;
+        return;
+    }
+    std::string::size_type bar = element.find('|');
+    if (bar != std::string::npos)
+    {
+        ParseIndices(element.substr(0, bar), token);
+        ParseIndices(element.substr(bar + 1), token);
+        return;
+    }
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
+        dash < rightBracket)
+    {
+        uint32_t min;
+        uint32_t max;
+        if (StringToUint32(element.substr(1, dash - 1), &min) &&
+            StringToUint32(element.substr(dash + 1, rightBracket - (dash + 1)), &max) &&
+            min <= max)
+        {
+            token.m_indices.emplace_back(min, max);
+        }
+        return;
+    }
+    uint32_t value;
+    if (StringToUint32(element, &value))
+    {
+        token.m_indices.emplace_back(value, value);
+    }
+}
+
+bool
+CompiledPath::Impl::StringToUint32(std::string str, uint32_t* value)
+{
+    std::istringstream iss;
+    iss.str(str);
+    iss >> (*value);
+    return !iss.bad() && !iss.fail();
+}
+
+bool
+CompiledPath::Impl::Matches(const Token& token, std::size_t index)
+{
+    if (token.m_allIndices)
+    {
+        return true;
+    }
+    for (const auto& range : token.m_indices)
+    {
+        if (index >= range.first && index <= range.second)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::vector<CompiledPath::Impl::Attribute>&
+CompiledPath::Impl::GetAttributes(Token& token, TypeId tid)
+{
+    auto it = token.m_attributes.find(tid.GetUid());
+    if (it != token.m_attributes.end())
+    {
+        return it->second;
+    }
+    NS_LOG_DEBUG("Cache the attributes " << token.m_item << " of " << tid.GetName());
+    std::vector<Attribute>& attributes = token.m_attributes[tid.GetUid()];
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            struct TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (info.name != token.m_item && token.m_item != "*")
+            {
+                continue;
+            }
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                attributes.push_back({info.name, info.accessor, nullptr});
+            }
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                attributes.push_back(
+                    {info.name,
+                     info.accessor,
+                     dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor))});
+            }
+        }
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return attributes;
+}
+
+void
+CompiledPath::Impl::Resolve(std::vector<Ptr<Object>>& objects, std::vector<std::string>& contexts)
+{
+    NS_LOG_FUNCTION(this);
+    m_objects = &objects;
+    m_contexts = &contexts;
+    for (std::size_t i = 0; i < GetRootNamespaceObjectN(); i++)
+    {
+        m_context = "/";
+        DoResolve(0, GetRootNamespaceObject(i));
+    }
+    m_context = "/";
+    DoResolve(0, nullptr);
+    m_objects = nullptr;
+    m_contexts = nullptr;
+}
+
+void
+CompiledPath::Impl::Descend(std::size_t i, const std::string& item, Ptr<Object> object)
+{
+    std::string::size_type length = m_context.size();
+    m_context += item;
+    m_context += '/';
+    DoResolve(i, object);
+    m_context.resize(length);
+}
+
+void
+CompiledPath::Impl::DoResolve(std::size_t i, Ptr<Object> root)
+{
+    if (i == m_tokens.size())
+    {
+        if (root)
+        {
+            m_objects->push_back(root);
+            m_contexts->push_back(m_context);
+        }
+        return;
+    }
+    Token& token = m_tokens[i];
+
+    // The name service and attribute lookups of Resolver::DoResolve
+    if (!root && token.m_item.compare(0, 5, "Names") == 0)
+    {
+        Descend(i + 1, token.m_item, nullptr);
+        return;
+    }
+    Ptr<Object> namedObject = Names::Find<Object>(root, token.m_item);
+    if (namedObject)
+    {
+        Descend(i + 1, token.m_item, namedObject);
+        return;
+    }
+    if (!root)
+    {
+        return;
+    }
+    if (token.m_isGetObject)
+    {
+        if (!token.m_isTypeIdFound)
+        {
+            TypeId::LookupByName(token.m_item.substr(1));
+        }
+        Ptr<Object> object = root->GetObject<Object>(token.m_tid);
+        if (object)
+        {
+            Descend(i + 1, token.m_item, object);
+        }
+        return;
+    }
+    for (const auto& attribute : GetAttributes(token, root->GetInstanceTypeId()))
+    {
+        if (attribute.m_container == nullptr)
+        {
+            PointerValue pValue;
+            attribute.m_accessor->Get(PeekPointer(root), pValue);
+            Ptr<Object> object = pValue.Get<Object>();
+            if (!object)
+            {
+                NS_LOG_ERROR("Requested object name=\"" << token.m_item << "\" exists on path=\""
+                                                        << m_context << "\" but is null.");
+                continue;
+            }
+            Descend(i + 1, attribute.m_name, object);
+        }
+        else
+        {
+            std::string::size_type length = m_context.size();
+            m_context += attribute.m_name;
+            m_context += '/';
+            DoArrayResolve(i + 1, root, attribute);
+            m_context.resize(length);
+        }
+    }
+}
+
+void
+CompiledPath::Impl::DoArrayResolve(std::size_t i, Ptr<Object> root, const Attribute& attribute)
+{
+    if (i == m_tokens.size())
+    {
+        return;
+    }
+    const Token& token = m_tokens[i];
+    std::size_t n;
+    if (!token.m_allIndices && attribute.m_container->GetN(PeekPointer(root), &n))
+    {
+        // Fetch only the requested positions, if they hold the same indices
+        std::vector<std::pair<std::size_t, Ptr<Object>>> elements;
+        bool ok = true;
+        for (const auto& range : token.m_indices)
+        {
+            for (std::size_t k = range.first; ok && k <= range.second && k < n; k++)
+            {
+                std::size_t index;
+                Ptr<Object> object = attribute.m_container->GetElement(PeekPointer(root), k, &index);
+                ok = index == k;
+                elements.emplace_back(k, object);
+            }
+        }
+        if (ok)
+        {
+            for (const auto& element : elements)
+            {
+                Descend(i + 1, std::to_string(element.first), element.second);
+            }
+            return;
+        }
+        NS_LOG_DEBUG("Container " << attribute.m_name << " is not indexed by position");
+    }
+    ObjectPtrContainerValue container;
+    attribute.m_accessor->Get(PeekPointer(root), container);
+    for (auto it = container.Begin(); it != container.End(); ++it)
+    {
+        if (Matches(token, it->first))
+        {
+            Descend(i + 1, std::to_string(it->first), it->second);
+        }
+    }
+}
+
+Ptr<const TraceSourceAccessor>
+CompiledPath::Impl::GetTraceSource(Ptr<Object> object)
+{
+    TypeId tid = object->GetInstanceTypeId();
+    auto it = m_traceSources.find(tid.GetUid());
+    if (it == m_traceSources.end())
+    {
+        it = m_traceSources.emplace(tid.GetUid(), tid.LookupTraceSourceByName(m_leaf)).first;
+    }
+    return it->second;
+}
+
+CompiledPath::CompiledPath(std::string path)
+    : m_impl(std::make_shared<Impl>(path))
+{
+    NS_LOG_FUNCTION(this << path);
+}
+
+CompiledPath::~CompiledPath()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+CompiledPath::GetPath() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_impl->m_path;
+}
+
+MatchContainer
+CompiledPath::LookupMatches() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Ptr<Object>> objects;
+    std::vector<std::string> contexts;
+    m_impl->Resolve(objects, contexts);
+    return MatchContainer(objects, contexts, m_impl->m_path);
+}
+
+void
+CompiledPath::Set(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    LookupMatches().Set(m_impl->m_leaf, value);
+}
+
+bool
+CompiledPath::SetFailSafe(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    return LookupMatches().SetFailSafe(m_impl->m_leaf, value);
+}
+
+bool
+CompiledPath::DoConnect(const CallbackBase& cb, bool context, bool connect) const
+{
+    std::vector<Ptr<Object>> objects;
+    std::vector<std::string> contexts;
+    m_impl->Resolve(objects, contexts);
+    bool ok = false;
+    for (std::size_t i = 0; i < objects.size(); i++)
+    {
+        Ptr<const TraceSourceAccessor> accessor = m_impl->GetTraceSource(objects[i]);
+        if (!accessor)
+        {
+            continue;
+        }
+        ObjectBase* object = PeekPointer(objects[i]);
+        if (context)
+        {
+            std::string ctx = contexts[i] + m_impl->m_leaf;
+            ok |= connect ? accessor->Connect(object, ctx, cb)
+                          : accessor->Disconnect(object, ctx, cb);
+        }
+        else
+        {
+            ok |= connect ? accessor->ConnectWithoutContext(object, cb)
+                          : accessor->DisconnectWithoutContext(object, cb);
+        }
+    }
+    if (!connect && objects.empty())
+    {
+        NS_LOG_WARN("Failed to disconnect " << m_impl->m_leaf << ", no object matches "
+                                            << m_impl->m_path);
+    }
+    return ok;
+}
+
+void
+CompiledPath::Connect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!DoConnect(cb, true, true))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_impl->m_path);
+    }
+}
+
+bool
+CompiledPath::ConnectFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return DoConnect(cb, true, true);
+}
+
+void
+CompiledPath::ConnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!DoConnect(cb, false, true))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_impl->m_path);
+    }
+}
+
+bool
+CompiledPath::ConnectWithoutContextFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return DoConnect(cb, false, true);
+}
+
+void
+CompiledPath::Disconnect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    DoConnect(cb, true, false);
+}
+
+void
+CompiledPath::DisconnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    DoConnect(cb, false, false);
+}
+
 } // namespace Config
 
 } // namespace ns3
@@ -21,6 +21,7 @@
 
 #include "ptr.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -361,6 +362,127 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+/**
+ * \ingroup config
+ * \brief A Config path parsed once, for repeated or bulk use.
+ *
+ * Config::Set and Config::Connect parse their path at each call, and
+ * look up the TypeId of each \c $TypeId element and the attributes of
+ * each object along the way by name. A CompiledPath splits the path into
+ * its elements, parses the index expressions and looks up the TypeIds
+ * once, and caches the attributes matching each element, and the trace
+ * source of the leaf, by TypeId of the objects on which they are
+ * resolved. When an object container is followed by explicit indices
+ * (e.g., "/NodeList/4" or "/NodeList/[2-5]"), only these indices are
+ * fetched from the container.
+ *
+ * The matches are resolved anew at each call, so a CompiledPath sees the
+ * objects created after its construction, and gives the same matches
+ * and contexts as the path given to Config::LookupMatches:
+ *
+ * \code
+ *   Config::CompiledPath cwnd("/NodeList/[0-9]/$ns3::TcpL4Protocol/SocketList/0/"
+ *                             "CongestionWindow");
+ *   cwnd.ConnectWithoutContext(MakeCallback(&CwndChange));
+ * \endcode
+ *
+ * Copies of a CompiledPath share their caches. A CompiledPath must not
+ * be used by several threads at the same time.
+ */
+class CompiledPath
+{
+  public:
+    /**
+     * Compile a path.
+     *
+     * \param [in] path A path to match attributes or trace sources: a path
+     *            to objects, followed by the name of an attribute or trace
+     *            source (the leaf).
+     */
+    CompiledPath(std::string path);
+    /** Destructor. */
+    ~CompiledPath();
+
+    /**
+     * \returns The path.
+     */
+    std::string GetPath() const;
+
+    /**
+     * \returns The objects matched by the path without its leaf, with
+     *          their contexts.
+     * \sa ns3::Config::LookupMatches
+     */
+    MatchContainer LookupMatches() const;
+
+    /**
+     * \param [in] value The value to set in all matching attributes.
+     * \sa ns3::Config::Set
+     */
+    void Set(const AttributeValue& value) const;
+    /**
+     * \param [in] value The value to set in all matching attributes.
+     * \returns \c true if any matching attributes could be set.
+     * \sa ns3::Config::SetFailSafe
+     */
+    bool SetFailSafe(const AttributeValue& value) const;
+    /**
+     * Connect a sink to all the matching trace sources, in a single
+     * resolution of the path.
+     *
+     * \param [in] cb The sink, which receives the context of each trace
+     *            source as first argument.
+     * \sa ns3::Config::Connect
+     */
+    void Connect(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The sink, which receives the context of each trace
+     *            source as first argument.
+     * \returns \c true if any trace sources could be connected.
+     * \sa ns3::Config::ConnectFailSafe
+     */
+    bool ConnectFailSafe(const CallbackBase& cb) const;
+    /**
+     * Connect a sink to all the matching trace sources, in a single
+     * resolution of the path.
+     *
+     * \param [in] cb The sink.
+     * \sa ns3::Config::ConnectWithoutContext
+     */
+    void ConnectWithoutContext(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The sink.
+     * \returns \c true if any trace sources could be connected.
+     * \sa ns3::Config::ConnectWithoutContextFailSafe
+     */
+    bool ConnectWithoutContextFailSafe(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The sink to disconnect from the matching trace sources.
+     * \sa ns3::Config::Disconnect
+     */
+    void Disconnect(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The sink to disconnect from the matching trace sources.
+     * \sa ns3::Config::DisconnectWithoutContext
+     */
+    void DisconnectWithoutContext(const CallbackBase& cb) const;
+
+  private:
+    class Impl;
+
+    /**
+     * Connect or disconnect a sink to the matching trace sources.
+     *
+     * \param [in] cb The sink.
+     * \param [in] context Whether the sink receives the context.
+     * \param [in] connect Whether to connect or disconnect the sink.
+     * \returns \c true if any trace sources could be connected.
+     */
+    bool DoConnect(const CallbackBase& cb, bool context, bool connect) const;
+
+    std::shared_ptr<Impl> m_impl; //!< The parsed path and the caches
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
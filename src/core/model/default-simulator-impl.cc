@@ -19,12 +19,18 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "boolean.h"
+#include "event-profiler.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
+#include <chrono>
 #include <cmath>
+#include <fstream>
 
 /**
  * \file
@@ -45,10 +51,32 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("EventProfile",
+                          "Measure the wall-clock time spent in the handler of each event, "
+                          "and report it at Simulator::Destroy.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&DefaultSimulatorImpl::m_eventProfile),
+                          MakeBooleanChecker())
+            .AddAttribute("EventProfileFile",
+                          "The file of the event profile report; the standard output if empty.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_eventProfileFile),
+                          MakeStringChecker())
+            .AddAttribute("EventRateInterval",
+                          "The sampling interval of the event rate.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&DefaultSimulatorImpl::m_eventRateInterval),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddTraceSource("EventRate",
+                            "The number of events per wall-clock second, "
+                            "sampled when EventProfile is enabled.",
+                            MakeTraceSourceAccessor(&DefaultSimulatorImpl::m_eventRate),
+                            "ns3::DefaultSimulatorImpl::EventRateTracedCallback");
     return tid;
 }
 
@@ -62,8 +90,9 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_eventsWithContext = nullptr;
     m_mainThreadId = std::this_thread::get_id();
+    m_eventProfile = false;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl()
@@ -100,6 +129,21 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+
+    if (m_profiler)
+    {
+        if (m_eventProfileFile.empty())
+        {
+            PrintEventProfile(std::cout);
+        }
+        else
+        {
+            std::ofstream os(m_eventProfileFile);
+            NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot open " << m_eventProfileFile);
+            PrintEventProfile(os);
+        }
+        m_profiler = nullptr;
+    }
 }
 
 void
@@ -141,7 +185,23 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler && !next.impl->IsCancelled())
+    {
+        // Get the handler first, since the event may delete its object
+        EventImpl::Handler handler = next.impl->GetHandler();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        next.impl->Invoke();
+        m_profiler->Record(handler, m_currentContext, std::chrono::steady_clock::now() - start);
+        double rate;
+        if (m_profiler->Sample(m_currentTs, rate))
+        {
+            m_eventRate(TimeStep(m_currentTs), rate);
+        }
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -156,30 +216,34 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    if (m_eventsWithContext.load(std::memory_order_relaxed) == nullptr)
     {
         return;
     }
 
-    // swap queues
-    EventsWithContext eventsWithContext;
+    // take the whole stack, and reverse it to get the events in order
+    EventWithContext* head = m_eventsWithContext.exchange(nullptr, std::memory_order_acquire);
+    EventWithContext* eventsWithContext = nullptr;
+    while (head != nullptr)
     {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        EventWithContext* next = head->next;
+        head->next = eventsWithContext;
+        eventsWithContext = head;
+        head = next;
     }
-    while (!eventsWithContext.empty())
+    while (eventsWithContext != nullptr)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
+        EventWithContext* event = eventsWithContext;
+        eventsWithContext = event->next;
         Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
+        ev.impl = event->event;
+        ev.key.m_ts = m_currentTs + event->timestamp;
+        ev.key.m_context = event->context;
         ev.key.m_uid = m_uid;
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
+        delete event;
     }
 }
 
@@ -191,6 +255,10 @@ DefaultSimulatorImpl::Run()
     m_mainThreadId = std::this_thread::get_id();
     ProcessEventsWithContext();
     m_stop = false;
+    if (m_eventProfile && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>(m_eventRateInterval.GetTimeStep());
+    }
 
     while (!m_events->IsEmpty() && !m_stop)
     {
@@ -259,15 +327,17 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
     }
     else
     {
-        EventWithContext ev;
-        ev.context = context;
+        EventWithContext* ev = new EventWithContext;
+        ev->context = context;
         // Current time added in ProcessEventsWithContext()
-        ev.timestamp = delay.GetTimeStep();
-        ev.event = event;
+        ev->timestamp = delay.GetTimeStep();
+        ev->event = event;
+        ev->next = m_eventsWithContext.load(std::memory_order_relaxed);
+        while (!m_eventsWithContext.compare_exchange_weak(ev->next,
+                                                          ev,
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed))
         {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
         }
     }
 }
@@ -405,4 +475,14 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+void
+DefaultSimulatorImpl::PrintEventProfile(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    if (m_profiler)
+    {
+        m_profiler->Print(os);
+    }
+}
+
 } // namespace ns3
@@ -20,10 +20,15 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "nstime.h"
 #include "simulator-impl.h"
+#include "traced-callback.h"
 
+#include <atomic>
 #include <list>
-#include <mutex>
+#include <memory>
+#include <ostream>
+#include <string>
 #include <thread>
 
 /**
@@ -36,12 +41,17 @@ namespace ns3
 {
 
 // Forward
+class EventProfiler;
 class Scheduler;
 
 /**
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the EventProfile attribute is set, the simulator measures the
+ * wall-clock time spent in the handler of each event (see EventProfiler),
+ * and writes the report at Simulator::Destroy().
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -78,6 +88,22 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Print the event profile, if EventProfile is enabled.
+     *
+     * \param [in,out] os The output stream.
+     */
+    void PrintEventProfile(std::ostream& os) const;
+
+    /**
+     * TracedCallback signature for the event rate.
+     *
+     * \param [in] now The current simulation time.
+     * \param [in] rate The number of events per wall-clock second since
+     *             the previous sample.
+     */
+    typedef void (*EventRateTracedCallback)(Time now, double rate);
+
   private:
     void DoDispose() override;
 
@@ -95,18 +121,17 @@ class DefaultSimulatorImpl : public SimulatorImpl
         uint64_t timestamp;
         /** The event implementation. */
         EventImpl* event;
+        /** The event pushed before this one. */
+        EventWithContext* next;
     };
-    /** Container type for the events from a different context. */
-    typedef std::list<struct EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * The events from a different context, in reverse order of insertion.
+     *
+     * The other threads push events on this lock-free stack, and the main
+     * thread takes the whole stack at once, so that checking for new events
+     * costs a single relaxed load.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    std::atomic<EventWithContext*> m_eventsWithContext;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -135,6 +160,17 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Profile the event handlers. */
+    bool m_eventProfile;
+    /** File of the event profile report, or empty for the standard output. */
+    std::string m_eventProfileFile;
+    /** Sampling interval of the event rate. */
+    Time m_eventRateInterval;
+    /** The event profiler, created by Run() if m_eventProfile is set. */
+    std::unique_ptr<EventProfiler> m_profiler;
+    /** The event rate trace. */
+    TracedCallback<Time, double> m_eventRate;
 };
 
 } // namespace ns3
@@ -21,6 +21,9 @@
 
 #include "log.h"
 
+#include <atomic>
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -32,6 +35,125 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/** Granularity of the event size classes, in bytes. */
+constexpr std::size_t POOL_GRANULARITY = alignof(std::max_align_t);
+/** Number of size classes; larger events use the global allocator. */
+constexpr std::size_t POOL_CLASSES = 16;
+/** Maximum number of released blocks cached per size class and thread. */
+constexpr uint32_t POOL_MAX_CACHED = 4096;
+
+/** A released block, linked in the free list of its size class. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next released block
+};
+
+/**
+ * Free lists of a thread.
+ *
+ * The struct is trivially destructible, so it stays usable while the
+ * thread-local objects are destroyed at thread exit.
+ */
+struct EventPool
+{
+    FreeBlock* head[POOL_CLASSES]; //!< Free list of each size class
+    uint32_t count[POOL_CLASSES];  //!< Length of each free list
+    bool registered;               //!< True once the reaper is registered
+    bool closed;                   //!< True once the reaper has run
+};
+
+/** The free lists of the current thread. */
+thread_local EventPool g_eventPool{};
+
+/** Whether released events are reused. */
+std::atomic<bool> g_eventPoolEnabled{true};
+
+/** Returns the cached blocks of a thread to the global allocator at thread exit. */
+struct EventPoolReaper
+{
+    /** Free the cached blocks and close the pool. */
+    ~EventPoolReaper()
+    {
+        EventPool& pool = g_eventPool;
+        for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+        {
+            while (pool.head[i] != nullptr)
+            {
+                FreeBlock* block = pool.head[i];
+                pool.head[i] = block->next;
+                ::operator delete(block);
+            }
+            pool.count[i] = 0;
+        }
+        pool.closed = true;
+    }
+};
+
+} // unnamed namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t sizeClass = (size - 1) / POOL_GRANULARITY;
+    if (sizeClass >= POOL_CLASSES)
+    {
+        return ::operator new(size);
+    }
+    EventPool& pool = g_eventPool;
+    FreeBlock* block = pool.head[sizeClass];
+    if (block != nullptr && g_eventPoolEnabled.load(std::memory_order_relaxed))
+    {
+        pool.head[sizeClass] = block->next;
+        pool.count[sizeClass]--;
+        return block;
+    }
+    // Always allocate the full class size, so that any block of the
+    // class can be reused for any event of the class.
+    return ::operator new((sizeClass + 1) * POOL_GRANULARITY);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    std::size_t sizeClass = (size - 1) / POOL_GRANULARITY;
+    EventPool& pool = g_eventPool;
+    if (sizeClass < POOL_CLASSES && !pool.closed && pool.count[sizeClass] < POOL_MAX_CACHED &&
+        g_eventPoolEnabled.load(std::memory_order_relaxed))
+    {
+        if (!pool.registered)
+        {
+            pool.registered = true;
+            static thread_local EventPoolReaper reaper;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = pool.head[sizeClass];
+        pool.head[sizeClass] = block;
+        pool.count[sizeClass]++;
+        return;
+    }
+    ::operator delete(p);
+}
+
+void
+EventImpl::SetPoolEnabled(bool enabled)
+{
+    NS_LOG_FUNCTION(enabled);
+    g_eventPoolEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool
+EventImpl::IsPoolEnabled()
+{
+    return g_eventPoolEnabled.load(std::memory_order_relaxed);
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -47,7 +169,11 @@ void
 EventImpl::Invoke()
 {
     NS_LOG_FUNCTION(this);
+#ifdef NS3_MTP
+    if (!m_cancel.load(std::memory_order_acquire))
+#else
     if (!m_cancel)
+#endif
     {
         Notify();
     }
@@ -57,14 +183,29 @@ void
 EventImpl::Cancel()
 {
     NS_LOG_FUNCTION(this);
+#ifdef NS3_MTP
+    m_cancel.store(true, std::memory_order_release);
+#else
     m_cancel = true;
+#endif
 }
 
 bool
 EventImpl::IsCancelled()
 {
     NS_LOG_FUNCTION(this);
+#ifdef NS3_MTP
+    return m_cancel.load(std::memory_order_acquire);
+#else
     return m_cancel;
+#endif
+}
+
+EventImpl::Handler
+EventImpl::GetHandler() const
+{
+    NS_LOG_FUNCTION(this);
+    return {&typeid(*this), nullptr, nullptr};
 }
 
 } // namespace ns3
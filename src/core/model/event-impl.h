@@ -21,7 +21,13 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
+#include <typeinfo>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 /**
  * \file
@@ -41,6 +47,13 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events are allocated from thread-local, size-class free lists: a
+ * released event goes back to the free list of its size class, up to a
+ * bounded number of cached blocks per class, and the next event of the
+ * same class reuses it without calling the global allocator. The pool
+ * can be disabled with SetPoolEnabled(), e.g. to compare against the
+ * plain allocator or to run memory checkers.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -67,6 +80,57 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * The function called by an event, used to profile the events.
+     */
+    struct Handler
+    {
+        const std::type_info* m_type;   //!< Type of the function, or of the event
+        const void* m_function;         //!< Address of the function, if known
+        const std::type_info* m_object; //!< Dynamic type of the object, for a member function
+    };
+
+    /**
+     * Get the function called by this event.
+     *
+     * The events created by MakeEvent() return the function or member
+     * function they call; the default implementation returns the type of
+     * the event.
+     *
+     * \returns The handler of the event.
+     */
+    virtual Handler GetHandler() const;
+
+    /**
+     * Allocate an event from the free list of its size class.
+     *
+     * \param [in] size The size of the event object.
+     * \returns The memory block.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release an event to the free list of its size class.
+     *
+     * \param [in] p The memory block.
+     * \param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
+
+    /**
+     * Enable or disable the reuse of released events.
+     *
+     * When disabled, released events are returned to the global allocator
+     * and new events are not taken from the free lists. The pool is
+     * enabled by default.
+     *
+     * \param [in] enabled Whether the pool is enabled.
+     */
+    static void SetPoolEnabled(bool enabled);
+    /**
+     * \returns true if released events are reused.
+     */
+    static bool IsPoolEnabled();
+
   protected:
     /**
      * Implementation for Invoke().
@@ -77,7 +141,19 @@ class EventImpl : public SimpleRefCount<EventImpl>
     virtual void Notify() = 0;
 
   private:
-    bool m_cancel; /**< Has this event been cancelled. */
+    /**
+     * Has this event been cancelled.
+     *
+     * \internal
+     * With multithreaded simulation support (NS3_MTP), an event can be
+     * cancelled by a logical process other than the one executing it,
+     * so the flag is atomic.
+     */
+#ifdef NS3_MTP
+    std::atomic<bool> m_cancel;
+#else
+    bool m_cancel;
+#endif
 };
 
 } // namespace ns3
@@ -0,0 +1,257 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "log.h"
+#include "nstime.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+namespace
+{
+
+/**
+ * \ingroup simulator
+ * Demangle a C++ symbol or type name.
+ *
+ * \param [in] mangled The mangled name.
+ * \returns The demangled name, or \pname{mangled} if it cannot be demangled.
+ */
+std::string
+Demangle(const char* mangled)
+{
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        std::string ret = demangled;
+        std::free(demangled);
+        return ret;
+    }
+#endif
+    return mangled;
+}
+
+/**
+ * \ingroup simulator
+ * Format an event count with a k or M suffix.
+ *
+ * \param [in] count The count.
+ * \returns The formatted count.
+ */
+std::string
+FormatCount(uint64_t count)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    if (count >= 1000000)
+    {
+        oss << count / 1e6 << "M";
+    }
+    else if (count >= 10000)
+    {
+        oss << count / 1e3 << "k";
+    }
+    else
+    {
+        oss << count;
+    }
+    return oss.str();
+}
+
+} // unnamed namespace
+
+bool
+EventProfiler::Key::operator==(const Key& o) const
+{
+    return m_handler.m_type == o.m_handler.m_type &&
+           m_handler.m_function == o.m_handler.m_function &&
+           m_handler.m_object == o.m_handler.m_object && m_context == o.m_context;
+}
+
+std::size_t
+EventProfiler::KeyHash::operator()(const Key& key) const
+{
+    std::size_t h = std::hash<const void*>()(key.m_handler.m_function);
+    h = h * 31 + std::hash<const void*>()(key.m_handler.m_type);
+    h = h * 31 + std::hash<const void*>()(key.m_handler.m_object);
+    return h * 31 + key.m_context;
+}
+
+EventProfiler::EventProfiler(uint64_t interval)
+    : m_events(0),
+      m_time(0),
+      m_interval(interval),
+      m_nextSample(interval),
+      m_sampleEvents(0),
+      m_sampleTime(std::chrono::steady_clock::now())
+{
+    NS_LOG_FUNCTION(this << interval);
+}
+
+void
+EventProfiler::Record(const EventImpl::Handler& handler,
+                      uint32_t context,
+                      std::chrono::steady_clock::duration duration)
+{
+    Stats& stats = m_stats[Key{handler, context}];
+    stats.m_count++;
+    stats.m_time += duration;
+    m_events++;
+    m_time += duration;
+}
+
+bool
+EventProfiler::Sample(uint64_t ts, double& rate)
+{
+    if (ts < m_nextSample)
+    {
+        return false;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - m_sampleTime).count();
+    rate = elapsed > 0 ? (m_events - m_sampleEvents) / elapsed : 0;
+    m_rates.emplace_back(ts, rate);
+    m_sampleEvents = m_events;
+    m_sampleTime = now;
+    // Skip the intervals without events
+    m_nextSample = (ts / m_interval + 1) * m_interval;
+    return true;
+}
+
+std::string
+EventProfiler::GetName(const EventImpl::Handler& handler)
+{
+#ifndef _WIN32
+    Dl_info info;
+    if (handler.m_function != nullptr && dladdr(handler.m_function, &info) != 0 &&
+        info.dli_sname != nullptr && info.dli_saddr == handler.m_function)
+    {
+        return Demangle(info.dli_sname);
+    }
+#endif
+    std::ostringstream oss;
+    if (handler.m_object != nullptr)
+    {
+        // A virtual member function, or a function without symbol
+        oss << Demangle(handler.m_object->name()) << "::";
+    }
+    oss << "<" << Demangle(handler.m_type->name());
+    if (handler.m_function != nullptr)
+    {
+        // Tell apart the functions of the same type, e.g., the virtual
+        // functions of a class with the same signature
+        oss << " " << handler.m_function;
+    }
+    oss << ">";
+    return oss.str();
+}
+
+void
+EventProfiler::Print(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    typedef std::pair<std::string, Stats> Row;
+
+    std::map<std::string, Stats> handlers;
+    std::vector<Row> contexts;
+    for (const auto& entry : m_stats)
+    {
+        std::string name = GetName(entry.first.m_handler);
+        Stats& stats = handlers[name];
+        stats.m_count += entry.second.m_count;
+        stats.m_time += entry.second.m_time;
+        std::ostringstream oss;
+        oss << name << " [";
+        if (entry.first.m_context == 0xffffffff)
+        {
+            oss << "no context]";
+        }
+        else
+        {
+            oss << "context " << entry.first.m_context << "]";
+        }
+        contexts.emplace_back(oss.str(), entry.second);
+    }
+
+    auto byTime = [](const Row& a, const Row& b) {
+        return a.second.m_time > b.second.m_time ||
+               (a.second.m_time == b.second.m_time && a.first < b.first);
+    };
+    std::vector<Row> rows(handlers.begin(), handlers.end());
+    std::sort(rows.begin(), rows.end(), byTime);
+    std::sort(contexts.begin(), contexts.end(), byTime);
+    contexts.resize(std::min(contexts.size(), MAX_CONTEXT_ROWS));
+
+    double total = std::chrono::duration<double>(m_time).count();
+    auto printRow = [&os, total](const Row& row) {
+        double time = std::chrono::duration<double>(row.second.m_time).count();
+        os << std::setw(6) << (total > 0 ? 100 * time / total : 0) << "% / " << std::setw(6)
+           << FormatCount(row.second.m_count) << " events " << std::setw(10)
+           << 1e6 * time / row.second.m_count << " us/event  " << row.first << std::endl;
+    };
+
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+    os << "Event profile: " << FormatCount(m_events) << " events, " << std::setprecision(3)
+       << total << " s in handlers" << std::endl;
+    os << std::setprecision(1);
+    os << "By handler:" << std::endl;
+    for (const auto& row : rows)
+    {
+        printRow(row);
+    }
+    os << "By handler and context:" << std::endl;
+    for (const auto& row : contexts)
+    {
+        printRow(row);
+    }
+    os.flags(flags);
+    os.precision(precision);
+    os << "Event rate (time, events/s):" << std::endl;
+    for (const auto& rate : m_rates)
+    {
+        os << TimeStep(rate.first).As(Time::S) << " " << static_cast<uint64_t>(rate.second)
+           << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,152 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "event-impl.h"
+
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Attribute the wall-clock time of the events to their handlers.
+ *
+ * The simulator records, for each executed event, the handler of the
+ * event (see EventImpl::GetHandler()), its context and the wall-clock
+ * time spent in the handler. The report lists the handlers by decreasing
+ * total time, first summed over all the contexts, then for the most
+ * expensive handler and context pairs.
+ *
+ * The profiler also samples the event rate: every \c interval of
+ * simulation time, it computes the number of events executed per
+ * wall-clock second since the previous sample.
+ *
+ * Handlers are named from the symbol of their function when it can be
+ * found (e.g., "ns3::TcpSocketBase::SendPendingData(bool)"), otherwise
+ * from the type of the function and of the object it is called on.
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] interval The event rate sampling interval, in time steps.
+     */
+    EventProfiler(uint64_t interval);
+
+    /**
+     * Record an executed event.
+     *
+     * \param [in] handler The handler of the event.
+     * \param [in] context The context of the event.
+     * \param [in] duration The wall-clock time spent in the handler.
+     */
+    void Record(const EventImpl::Handler& handler,
+                uint32_t context,
+                std::chrono::steady_clock::duration duration);
+
+    /**
+     * Sample the event rate, if the sampling interval has elapsed.
+     *
+     * \param [in] ts The time stamp of the current event.
+     * \param [out] rate The event rate, in events per wall-clock second,
+     *              since the previous sample.
+     * \returns true if a sample was taken.
+     */
+    bool Sample(uint64_t ts, double& rate);
+
+    /**
+     * Print the report.
+     *
+     * \param [in,out] os The output stream.
+     */
+    void Print(std::ostream& os) const;
+
+    /**
+     * Get a readable name for an event handler.
+     *
+     * \param [in] handler The handler.
+     * \returns The name of the handler.
+     */
+    static std::string GetName(const EventImpl::Handler& handler);
+
+  private:
+    /** The key of the statistics: a handler and a context. */
+    struct Key
+    {
+        EventImpl::Handler m_handler; //!< The handler
+        uint32_t m_context;           //!< The context
+
+        /**
+         * Compare keys.
+         *
+         * \param [in] o The other key.
+         * \returns true if the keys are equal.
+         */
+        bool operator==(const Key& o) const;
+    };
+
+    /** Hash function for Key. */
+    struct KeyHash
+    {
+        /**
+         * \param [in] key The key.
+         * \returns The hash of the key.
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /** The statistics of a key. */
+    struct Stats
+    {
+        uint64_t m_count{0};                           //!< Number of events
+        std::chrono::steady_clock::duration m_time{0}; //!< Total wall-clock time
+    };
+
+    /** Maximum number of handler and context pairs in the report. */
+    static constexpr std::size_t MAX_CONTEXT_ROWS = 20;
+
+    std::unordered_map<Key, Stats, KeyHash> m_stats; //!< Statistics of each key
+    uint64_t m_events;                               //!< Number of recorded events
+    std::chrono::steady_clock::duration m_time;      //!< Total time in handlers
+
+    uint64_t m_interval;                                //!< Sampling interval
+    uint64_t m_nextSample;                              //!< Time stamp of the next sample
+    uint64_t m_sampleEvents;                            //!< Events at the last sample
+    std::chrono::steady_clock::time_point m_sampleTime; //!< Wall-clock time of the last sample
+    std::vector<std::pair<uint64_t, double>> m_rates;   //!< Sampled time stamps and rates
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
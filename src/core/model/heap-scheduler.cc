@@ -236,7 +236,14 @@ HeapScheduler::Remove(const Event& ev)
             NS_ASSERT(m_heap[i].impl == ev.impl);
             Exch(i, Last());
             m_heap.pop_back();
-            TopDown(i);
+            // The last event, now at i, may belong above or below i
+            std::size_t index = i;
+            while (!IsBottom(index) && !IsRoot(index) && IsLessStrictly(index, Parent(index)))
+            {
+                Exch(index, Parent(index));
+                index = Parent(index);
+            }
+            TopDown(index);
             return;
         }
     }
@@ -0,0 +1,335 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(UINT64_MAX),
+      m_topMax(0),
+      m_nRungs(0),
+      m_bottomHead(0),
+      m_qSize(0)
+{
+    NS_LOG_FUNCTION(this);
+    // Rungs are never reallocated, so that references to them stay valid
+    m_rungs.reserve(MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::CurrentStart(const Rung& rung)
+{
+    return rung.m_start + rung.m_current * rung.m_width;
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    DoInsert(ev);
+    m_qSize++;
+    if (m_bottom.size() - m_bottomHead > THRESHOLD && m_nRungs < MAX_RUNGS)
+    {
+        SpawnFromBottom();
+    }
+    Refill();
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom[m_bottomHead++];
+    if (m_bottomHead == m_bottom.size())
+    {
+        m_bottom.clear();
+        m_bottomHead = 0;
+    }
+    m_qSize--;
+    Refill();
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+
+    Bucket* bucket = nullptr;
+    if (ts >= m_topStart)
+    {
+        bucket = &m_top;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+            Rung& rung = m_rungs[i];
+            if (ts >= CurrentStart(rung))
+            {
+                bucket = &rung.m_buckets[(ts - rung.m_start) / rung.m_width];
+                rung.m_count--;
+                break;
+            }
+        }
+    }
+
+    if (bucket != nullptr)
+    {
+        // Unsorted bucket: replace the event by the last one
+        Bucket::iterator it = bucket->begin();
+        while (it->key.m_uid != ev.key.m_uid)
+        {
+            ++it;
+            NS_ASSERT(it != bucket->end());
+        }
+        NS_ASSERT(ev.impl == it->impl);
+        *it = bucket->back();
+        bucket->pop_back();
+    }
+    else
+    {
+        Bucket::iterator it = std::lower_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+        NS_ASSERT(it != m_bottom.end() && it->key.m_uid == ev.key.m_uid);
+        m_bottom.erase(it);
+        if (m_bottomHead == m_bottom.size())
+        {
+            m_bottom.clear();
+            m_bottomHead = 0;
+        }
+    }
+    m_qSize--;
+    Refill();
+}
+
+void
+LadderScheduler::DoInsert(const Event& ev)
+{
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+        return;
+    }
+    for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+        Rung& rung = m_rungs[i];
+        if (ts >= CurrentStart(rung))
+        {
+            uint64_t index = (ts - rung.m_start) / rung.m_width;
+            NS_ASSERT(index < rung.m_nBuckets);
+            NS_LOG_LOGIC("insert in rung " << i << ", bucket " << index);
+            rung.m_buckets[index].push_back(ev);
+            rung.m_count++;
+            return;
+        }
+    }
+    InsertBottom(ev);
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    Bucket::iterator first = m_bottom.begin() + m_bottomHead;
+    Bucket::iterator it = std::upper_bound(first, m_bottom.end(), ev);
+    if (it == first && m_bottomHead > 0)
+    {
+        // Reuse the room left by the events already removed
+        m_bottom[--m_bottomHead] = ev;
+    }
+    else
+    {
+        m_bottom.insert(it, ev);
+    }
+}
+
+void
+LadderScheduler::AddRung(uint64_t start, uint64_t end, uint64_t last, std::size_t nEvents)
+{
+    NS_LOG_FUNCTION(this << start << end << last << nEvents);
+    NS_ASSERT(m_nRungs < MAX_RUNGS && start <= last && last < end && nEvents > 0);
+
+    uint64_t width = std::max<uint64_t>((last - start + nEvents) / nEvents, 1);
+    uint64_t nBuckets = (end - start + width - 1) / width;
+    if (nBuckets > MAX_BUCKETS)
+    {
+        nBuckets = MAX_BUCKETS;
+        width = (end - start + nBuckets - 1) / nBuckets;
+    }
+
+    if (m_nRungs == m_rungs.size())
+    {
+        m_rungs.emplace_back();
+    }
+    Rung& rung = m_rungs[m_nRungs++];
+    if (rung.m_buckets.size() < nBuckets)
+    {
+        rung.m_buckets.resize(nBuckets);
+    }
+    rung.m_nBuckets = nBuckets;
+    rung.m_current = 0;
+    rung.m_start = start;
+    rung.m_width = width;
+    rung.m_count = 0;
+    NS_LOG_LOGIC("rung " << m_nRungs - 1 << ": " << nBuckets << " buckets of " << width);
+}
+
+void
+LadderScheduler::Spread(Bucket& events, std::size_t first)
+{
+    Rung& rung = m_rungs[m_nRungs - 1];
+    for (std::size_t i = first; i < events.size(); i++)
+    {
+        uint64_t index = (events[i].key.m_ts - rung.m_start) / rung.m_width;
+        NS_ASSERT(index < rung.m_nBuckets);
+        rung.m_buckets[index].push_back(events[i]);
+    }
+    rung.m_count += events.size() - first;
+    events.clear();
+}
+
+void
+LadderScheduler::SpawnFromBottom()
+{
+    NS_LOG_FUNCTION(this);
+    uint64_t start = m_bottom[m_bottomHead].key.m_ts;
+    uint64_t last = m_bottom.back().key.m_ts;
+    if (start == last)
+    {
+        // A finer rung would not split these events
+        return;
+    }
+    uint64_t end = m_nRungs > 0 ? CurrentStart(m_rungs[m_nRungs - 1]) : m_topStart;
+    AddRung(start, end, last, m_bottom.size() - m_bottomHead);
+    Spread(m_bottom, m_bottomHead);
+    m_bottomHead = 0;
+}
+
+void
+LadderScheduler::Refill()
+{
+    while (m_bottomHead == m_bottom.size() && m_qSize > 0)
+    {
+        if (m_nRungs == 0)
+        {
+            NS_ASSERT(!m_top.empty());
+            uint64_t start = m_topMin;
+            uint64_t last = m_topMax;
+            m_topStart = last + 1;
+            m_topMin = UINT64_MAX;
+            m_topMax = 0;
+            if (m_top.size() <= THRESHOLD || start == last)
+            {
+                m_bottom.swap(m_top);
+                std::sort(m_bottom.begin(), m_bottom.end());
+                return;
+            }
+            AddRung(start, last + 1, last, m_top.size());
+            Spread(m_top, 0);
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.m_count == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.m_buckets[rung.m_current].empty())
+        {
+            rung.m_current++;
+        }
+        Bucket& bucket = rung.m_buckets[rung.m_current];
+        uint64_t end = CurrentStart(rung) + rung.m_width;
+        rung.m_current++;
+        rung.m_count -= bucket.size();
+
+        uint64_t start = UINT64_MAX;
+        uint64_t last = 0;
+        if (bucket.size() > THRESHOLD && m_nRungs < MAX_RUNGS)
+        {
+            for (const auto& ev : bucket)
+            {
+                start = std::min(start, ev.key.m_ts);
+                last = std::max(last, ev.key.m_ts);
+            }
+        }
+        if (start >= last)
+        {
+            // Few events, or they cannot be split further
+            m_bottom.swap(bucket);
+            std::sort(m_bottom.begin(), m_bottom.end());
+            return;
+        }
+        AddRung(start, end, last, bucket.size());
+        Spread(bucket, 0);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,190 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the Ladder Queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang]. The events are kept in three tiers:
+ *
+ *  - Top, an unsorted vector of the events beyond the time covered by
+ *    the ladder;
+ *  - the Ladder, a stack of rungs; each rung is an array of buckets of
+ *    uniform width, and each bucket an unsorted vector of events. A rung
+ *    covers the time span of one bucket of the rung above it;
+ *  - Bottom, a short sorted vector of the earliest events.
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are inserted in the first tier whose time span contains them,
+ * without sorting unless they fall into Bottom. When Bottom is empty, the
+ * first non-empty bucket of the lowest rung is either sorted into Bottom,
+ * when it holds at most THRESHOLD events, or spread over a new, finer
+ * rung. When the ladder is empty, Top is spread over a new first rung,
+ * whose bucket width is derived from the span and number of events in
+ * Top. The width of the buckets thus adapts to the event distribution,
+ * and each event is moved a bounded number of times.
+ *
+ * Buckets are vectors, so events are stored contiguously, and the rungs
+ * and their buckets are kept when they are emptied, so that their storage
+ * is reused by the following rungs.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to a bucket, or sorted insert in Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom kept sorted
+ * Remove()     | ~Constant       | Search within bucket
+ * RemoveNext() | ~Constant       | Bounded number of moves per event
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | Rungs and bucket vectors         | Kept for reuse
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Bucket type: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        std::vector<Bucket> m_buckets; //!< Buckets, possibly more than m_nBuckets for reuse
+        uint32_t m_nBuckets;           //!< Number of buckets in use
+        uint32_t m_current;            //!< Index of the first bucket which may be non-empty
+        uint64_t m_start;              //!< Start time of the first bucket
+        uint64_t m_width;              //!< Width of each bucket
+        uint32_t m_count;              //!< Number of events in the rung
+    };
+
+    /**
+     * Get the start time of the current bucket of a rung.
+     *
+     * Events of the rung are at or after this time.
+     *
+     * \param [in] rung The rung.
+     * \returns The start time of the current bucket.
+     */
+    static uint64_t CurrentStart(const Rung& rung);
+
+    /**
+     * Insert an event in Top, the ladder or Bottom.
+     *
+     * \param [in] ev The event.
+     */
+    void DoInsert(const Scheduler::Event& ev);
+
+    /**
+     * Insert an event in Bottom, keeping it sorted.
+     *
+     * \param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+
+    /**
+     * Add a rung to the ladder, covering a time span.
+     *
+     * The width of the buckets is chosen to spread \pname{nEvents} events
+     * between \pname{start} and \pname{last} over as many buckets.
+     *
+     * \param [in] start The start of the time span.
+     * \param [in] end The end of the time span (excluded).
+     * \param [in] last The time stamp of the last event to be stored.
+     * \param [in] nEvents The number of events to be stored in the rung.
+     */
+    void AddRung(uint64_t start, uint64_t end, uint64_t last, std::size_t nEvents);
+
+    /**
+     * Move events into the lowest rung.
+     *
+     * \param [in] events The events to move, from \pname{first}; cleared on return.
+     * \param [in] first The index of the first event to move.
+     */
+    void Spread(Bucket& events, std::size_t first);
+
+    /**
+     * Move the events of Bottom into a new rung.
+     *
+     * This is called when Bottom grows beyond THRESHOLD events, which
+     * makes the sorted insertion expensive.
+     */
+    void SpawnFromBottom();
+
+    /** Move the next events into Bottom, if it is empty. */
+    void Refill();
+
+    static constexpr uint32_t THRESHOLD = 50;      //!< Maximum events sorted at once
+    static constexpr uint32_t MAX_RUNGS = 8;       //!< Maximum number of rungs
+    static constexpr uint32_t MAX_BUCKETS = 65536; //!< Maximum number of buckets per rung
+
+    Bucket m_top;              //!< Events beyond the ladder, unsorted
+    uint64_t m_topStart;       //!< Time at which Top starts
+    uint64_t m_topMin;         //!< Minimum time stamp in Top
+    uint64_t m_topMax;         //!< Maximum time stamp in Top
+    std::vector<Rung> m_rungs; //!< Rungs, possibly more than m_nRungs for reuse
+    uint32_t m_nRungs;         //!< Number of rungs in use
+    Bucket m_bottom;           //!< Earliest events, sorted from m_bottomHead
+    std::size_t m_bottomHead;  //!< Index of the first event of Bottom
+    uint32_t m_qSize;          //!< Number of events in the queue
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
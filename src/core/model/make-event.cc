@@ -52,6 +52,11 @@ MakeEvent(void (*f)())
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function);
+        }
+
       protected:
         void Notify() override
         {
@@ -353,6 +353,13 @@ EventImpl* MakeEvent(T function);
 #include "event-impl.h"
 #include "type-traits.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+
 namespace ns3
 {
 
@@ -392,6 +399,115 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Helper for MakeEventHandler which gets the class of a class method.
+ *
+ * This is the generic template declaration, for the unsupported types.
+ *
+ * \tparam MEM \explicit The class method function signature.
+ */
+template <typename MEM>
+struct MemberFunctionClass
+{
+    typedef void Type; //!< The class type, void if unknown
+};
+
+/**
+ * \ingroup makeeventmemptr
+ * Helper for MakeEventHandler which gets the class of a class method.
+ *
+ * This is the specialization for the non-const methods.
+ *
+ * \tparam R \explicit The return type.
+ * \tparam C \explicit The class type.
+ * \tparam Args \explicit The argument types.
+ */
+template <typename R, typename C, typename... Args>
+struct MemberFunctionClass<R (C::*)(Args...)>
+{
+    typedef C Type; //!< The class type
+};
+
+/**
+ * \ingroup makeeventmemptr
+ * Helper for MakeEventHandler which gets the class of a class method.
+ *
+ * This is the specialization for the const methods.
+ *
+ * \tparam R \explicit The return type.
+ * \tparam C \explicit The class type.
+ * \tparam Args \explicit The argument types.
+ */
+template <typename R, typename C, typename... Args>
+struct MemberFunctionClass<R (C::*)(Args...) const>
+{
+    typedef C Type; //!< The class type
+};
+
+/**
+ * \ingroup makeeventmemptr
+ * Get the handler of an event which calls a class method.
+ *
+ * \tparam MEM \deduced The class method function signature.
+ * \tparam T \deduced The class type.
+ * \param [in] mem_ptr Class method member function pointer.
+ * \param [in] obj The object on which the method is called.
+ * \returns The handler.
+ */
+template <typename MEM, typename T>
+EventImpl::Handler
+MakeEventHandler(MEM mem_ptr, const T& obj)
+{
+    static_assert(sizeof(MEM) >= sizeof(void*), "Unexpected member function pointer size");
+    EventImpl::Handler handler{&typeid(MEM), nullptr, &typeid(obj)};
+    // The member function pointer starts with the address of the function,
+    // or, for a virtual function, with a value which matches no symbol.
+    std::memcpy(&handler.m_function, &mem_ptr, sizeof(handler.m_function));
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(_WIN32)
+    // In the Itanium C++ ABI, the pointer to a virtual function holds one
+    // plus the offset of the function in the virtual table, followed by the
+    // adjustment of the object pointer. Look the final overrider up in the
+    // virtual table of the object, so that the virtual functions of a class
+    // with the same signature are told apart, and named.
+    typedef typename MemberFunctionClass<MEM>::Type C;
+    if constexpr (!std::is_void_v<C> && sizeof(MEM) == sizeof(std::uintptr_t) * 2)
+    {
+        std::uintptr_t ptr;
+        std::ptrdiff_t adj;
+        std::memcpy(&ptr, &mem_ptr, sizeof(ptr));
+        std::memcpy(&adj, reinterpret_cast<const char*>(&mem_ptr) + sizeof(ptr), sizeof(adj));
+        if (ptr & 1)
+        {
+            const C& base = obj;
+            const char* self = reinterpret_cast<const char*>(std::addressof(base)) + adj;
+            const char* vtable;
+            std::memcpy(&vtable, self, sizeof(vtable));
+            std::memcpy(&handler.m_function, vtable + ptr - 1, sizeof(handler.m_function));
+        }
+    }
+#endif
+    return handler;
+}
+
+/**
+ * \ingroup makeeventfnptr
+ * Get the handler of an event which calls a function.
+ *
+ * \tparam F \deduced The function pointer type.
+ * \param [in] f The function pointer.
+ * \returns The handler.
+ */
+template <typename F>
+EventImpl::Handler
+MakeEventHandler(F f)
+{
+    static_assert(sizeof(F) == sizeof(void*), "Unexpected function pointer size");
+    EventImpl::Handler handler{&typeid(F), nullptr, nullptr};
+    std::memcpy(&handler.m_function, &f, sizeof(handler.m_function));
+    return handler;
+}
+
 template <typename MEM, typename OBJ>
 EventImpl*
 MakeEvent(MEM mem_ptr, OBJ obj)
@@ -410,6 +526,12 @@ MakeEvent(MEM mem_ptr, OBJ obj)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function,
+                                    EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
       private:
         void Notify() override
         {
@@ -443,6 +565,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function,
+                                    EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
       private:
         void Notify() override
         {
@@ -478,6 +606,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function,
+                                    EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
       private:
         void Notify() override
         {
@@ -515,6 +649,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function,
+                                    EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
       private:
         void Notify() override
         {
@@ -554,6 +694,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function,
+                                    EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
       private:
         void Notify() override
         {
@@ -602,6 +748,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function,
+                                    EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
       private:
         void Notify() override
         {
@@ -653,6 +805,12 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function,
+                                    EventMemberImplObjTraits<OBJ>::GetReference(m_obj));
+        }
+
       private:
         void Notify() override
         {
@@ -694,6 +852,11 @@ MakeEvent(void (*f)(U1), T1 a1)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function);
+        }
+
       private:
         void Notify() override
         {
@@ -729,6 +892,11 @@ MakeEvent(void (*f)(U1, U2), T1 a1, T2 a2)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function);
+        }
+
       private:
         void Notify() override
         {
@@ -766,6 +934,11 @@ MakeEvent(void (*f)(U1, U2, U3), T1 a1, T2 a2, T3 a3)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function);
+        }
+
       private:
         void Notify() override
         {
@@ -812,6 +985,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4), T1 a1, T2 a2, T3 a3, T4 a4)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function);
+        }
+
       private:
         void Notify() override
         {
@@ -862,6 +1040,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function);
+        }
+
       private:
         void Notify() override
         {
@@ -916,6 +1099,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5, U6), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5,
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return MakeEventHandler(m_function);
+        }
+
       private:
         void Notify() override
         {
@@ -950,6 +1138,11 @@ MakeEvent(T function)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return {&typeid(T), nullptr, nullptr};
+        }
+
       private:
         void Notify() override
         {
@@ -34,7 +34,7 @@
 #include "rng-stream.h"
 #include "string.h"
 
-#include <algorithm> // upper_bound
+#include <algorithm> // upper_bound, min
 #include <cmath>
 #include <iostream>
 
@@ -49,6 +49,73 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
+namespace
+{
+
+/**
+ * \ingroup randomvariable
+ * Uniform random numbers drawn in batches from a RngStream, for the
+ * GetValues() implementations.
+ *
+ * A batch never holds more numbers than the caller still needs, so the
+ * stream is left in the same state as after the equivalent GetValue()
+ * calls.
+ */
+class UniformBatch
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] rng The stream.
+     * \param [in] isAntithetic Whether to return 1 - u instead of u.
+     */
+    UniformBatch(RngStream* rng, bool isAntithetic)
+        : m_rng(rng),
+          m_isAntithetic(isAntithetic),
+          m_next(0),
+          m_size(0)
+    {
+    }
+
+    /**
+     * Get the next uniform random number.
+     *
+     * \param [in] needed The minimum number of random numbers the caller
+     *            still needs, including this one.
+     * \returns The random number.
+     */
+    double Next(std::size_t needed)
+    {
+        if (m_next == m_size)
+        {
+            m_size = std::min(needed, SIZE);
+            m_rng->RandU01(m_values, m_size);
+            if (m_isAntithetic)
+            {
+                for (std::size_t i = 0; i < m_size; i++)
+                {
+                    m_values[i] = 1 - m_values[i];
+                }
+            }
+            m_next = 0;
+        }
+        return m_values[m_next++];
+    }
+
+  private:
+    /** The maximum number of random numbers in a batch. */
+    static constexpr std::size_t SIZE = 256;
+
+    RngStream* m_rng;      //!< The stream
+    bool m_isAntithetic;   //!< Whether to return 1 - u
+    std::size_t m_next;    //!< The next random number in the batch
+    std::size_t m_size;    //!< The number of random numbers in the batch
+    double m_values[SIZE]; //!< The batch
+};
+
+} // unnamed namespace
+
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
 TypeId
@@ -142,6 +209,16 @@ RandomVariableStream::Peek() const
     return m_rng;
 }
 
+void
+RandomVariableStream::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        values[i] = GetValue();
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId
@@ -219,6 +296,27 @@ UniformRandomVariable::GetInteger()
     return (uint32_t)GetValue(m_min, m_max + 1);
 }
 
+void
+UniformRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    // The same operations as GetValue(), in loops the compiler can vectorize
+    Peek()->RandU01(values, n);
+    double min = m_min;
+    double max = m_max;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        values[i] = min + values[i] * (max - min);
+    }
+    if (IsAntithetic())
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            values[i] = min + (max - values[i]);
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
 TypeId
@@ -469,6 +567,26 @@ ExponentialRandomVariable::GetInteger()
     return (uint32_t)GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    UniformBatch batch(Peek(), IsAntithetic());
+    for (std::size_t i = 0; i < n; i++)
+    {
+        while (true)
+        {
+            // Each value needs at least one uniform random number
+            double r = -m_mean * std::log(batch.Next(n - i));
+            if (m_bound == 0 || r <= m_bound)
+            {
+                values[i] = r;
+                break;
+            }
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -811,6 +929,56 @@ NormalRandomVariable::GetInteger()
     return (uint32_t)GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    UniformBatch batch(Peek(), IsAntithetic());
+    double sd = std::sqrt(m_variance);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        // The same steps as GetValue(mean, variance, bound)
+        if (m_nextValid)
+        {
+            m_nextValid = false;
+            double x2 = m_mean + m_v2 * m_y * sd;
+            if (std::fabs(x2 - m_mean) <= m_bound)
+            {
+                values[i] = x2;
+                continue;
+            }
+        }
+        // Each pair of uniform random numbers gives at most two values
+        std::size_t needed = 2 * ((n - i + 1) / 2);
+        while (true)
+        {
+            double v1 = 2 * batch.Next(needed) - 1;
+            double v2 = 2 * batch.Next(needed - 1) - 1;
+            double w = v1 * v1 + v2 * v2;
+            if (w <= 1.0)
+            {
+                double y = std::sqrt((-2 * std::log(w)) / w);
+                double x1 = m_mean + v1 * y * sd;
+                if (std::fabs(x1 - m_mean) <= m_bound)
+                {
+                    m_nextValid = true;
+                    m_y = y;
+                    m_v2 = v2;
+                    values[i] = x1;
+                    break;
+                }
+                double x2 = m_mean + v2 * y * sd;
+                if (std::fabs(x2 - m_mean) <= m_bound)
+                {
+                    m_nextValid = false;
+                    values[i] = x2;
+                    break;
+                }
+            }
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
@@ -941,6 +1109,29 @@ LogNormalRandomVariable::GetInteger()
     return (uint32_t)GetValue(m_mu, m_sigma);
 }
 
+void
+LogNormalRandomVariable::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    UniformBatch batch(Peek(), IsAntithetic());
+    for (std::size_t i = 0; i < n; i++)
+    {
+        // The same steps as GetValue(mu, sigma); each value needs at least
+        // two uniform random numbers
+        std::size_t needed = 2 * (n - i);
+        double v1;
+        double r2;
+        do
+        {
+            v1 = -1 + 2 * batch.Next(needed);
+            double v2 = -1 + 2 * batch.Next(needed - 1);
+            r2 = v1 * v1 + v2 * v2;
+        } while (r2 > 1.0 || r2 == 0);
+        double normal = v1 * std::sqrt(-2.0 * std::log(r2) / r2);
+        values[i] = std::exp(m_sigma * normal + m_mu);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(GammaRandomVariable);
 
 TypeId
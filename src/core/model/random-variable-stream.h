@@ -154,6 +154,19 @@ class RandomVariableStream : public Object
      */
     virtual uint32_t GetInteger() = 0;
 
+    /**
+     * \brief Get the next random values drawn from the distribution.
+     *
+     * The values, and the state of the stream afterwards, are the same as
+     * with \pname{n} successive calls to GetValue(). The distributions
+     * which override this method draw the underlying uniform random
+     * numbers in batches, without a virtual call per value.
+     *
+     * \param [out] values The random values.
+     * \param [in] n The number of values.
+     */
+    virtual void GetValues(double* values, std::size_t n);
+
   protected:
     /**
      * \brief Get the pointer to the underlying RngStream.
@@ -277,6 +290,10 @@ class UniformRandomVariable : public RandomVariableStream
      * \note The upper limit is included in the output range.
      */
     uint32_t GetInteger() override;
+    /**
+     * \copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(double* values, std::size_t n) override;
 
   private:
     /** The lower bound on values that can be returned by this RNG stream. */
@@ -566,6 +583,10 @@ class ExponentialRandomVariable : public RandomVariableStream
     // Inherited from RandomVariableStream
     double GetValue() override;
     uint32_t GetInteger() override;
+    /**
+     * \copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(double* values, std::size_t n) override;
 
   private:
     /** The mean value of the unbounded exponential distribution. */
@@ -1221,6 +1242,10 @@ class NormalRandomVariable : public RandomVariableStream
      * which now involves the distances \f$u1\f$ and \f$u2\f$ are from 1.
      */
     uint32_t GetInteger() override;
+    /**
+     * \copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(double* values, std::size_t n) override;
 
   private:
     /** The mean value for the normal distribution returned by this RNG stream. */
@@ -1459,6 +1484,10 @@ class LogNormalRandomVariable : public RandomVariableStream
      * which now involves the distances \f$u1\f$ and \f$u2\f$ are from 1.
      */
     uint32_t GetInteger() override;
+    /**
+     * \copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(double* values, std::size_t n) override;
 
   private:
     /** The mu value for the log-normal distribution returned by this RNG stream. */
@@ -24,6 +24,10 @@
 #include "log.h"
 #include "uinteger.h"
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * \file
  * \ingroup randomvariable
@@ -40,7 +44,16 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
  * The next random number generator stream number to use
  * for automatic assignment.
  */
+#ifdef NS3_MTP
+static std::atomic<uint64_t> g_nextStreamIndex = 0;
+/**
+ * \relates RngSeedManager
+ * The stream index counter of the logical process run by the thread, if any.
+ */
+static thread_local uint64_t* g_streamIndexCounter = nullptr;
+#else
 static uint64_t g_nextStreamIndex = 0;
+#endif
 /**
  * \relates RngSeedManager
  * \anchor GlobalValueRngSeed
@@ -107,9 +120,22 @@ uint64_t
 RngSeedManager::GetNextStreamIndex()
 {
     NS_LOG_FUNCTION_NOARGS();
-    uint64_t next = g_nextStreamIndex;
-    g_nextStreamIndex++;
-    return next;
+#ifdef NS3_MTP
+    if (g_streamIndexCounter != nullptr)
+    {
+        return (*g_streamIndexCounter)++;
+    }
+#endif
+    return g_nextStreamIndex++;
+}
+
+#ifdef NS3_MTP
+void
+RngSeedManager::SetStreamIndexCounter(uint64_t* counter)
+{
+    NS_LOG_FUNCTION(counter);
+    g_streamIndexCounter = counter;
 }
+#endif
 
 } // namespace ns3
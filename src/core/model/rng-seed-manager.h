@@ -104,6 +104,23 @@ class RngSeedManager
      * \returns The next stream index.
      */
     static uint64_t GetNextStreamIndex();
+
+#ifdef NS3_MTP
+    /**
+     * Set the stream index counter of the calling thread.
+     *
+     * The streams automatically assigned by the thread take their index
+     * from \pname{counter}, which is incremented, instead of the global
+     * counter. The multithreaded simulator gives each logical process its
+     * own counter, starting at the index of the logical process shifted
+     * by 48 bits, and sets it while the logical process runs, so that the
+     * streams of each logical process do not depend on the thread
+     * scheduling.
+     *
+     * \param [in] counter The counter, or nullptr to use the global counter.
+     */
+    static void SetStreamIndexCounter(uint64_t* counter);
+#endif
 };
 
 /** Alias for compatibility. */
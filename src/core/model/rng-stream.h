@@ -70,6 +70,14 @@ class RngStream
      * \returns The next random.
      */
     double RandU01();
+    /**
+     * Generate the next random numbers for this stream: the same
+     * numbers as \pname{n} calls to RandU01().
+     *
+     * \param [out] values The random numbers.
+     * \param [in] n The number of random numbers.
+     */
+    void RandU01(double* values, std::size_t n);
 
   private:
     /**
@@ -27,6 +27,10 @@
 #include <limits>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * \file
  * \ingroup ptr
@@ -52,6 +56,10 @@ class empty
  * to a class. This template does not require this class to
  * have a virtual destructor or a specific (or any) parent class.
  *
+ * When ns-3 is built with multithreaded simulation support (NS3_MTP),
+ * the reference count is atomic, so that references to an object can be
+ * taken and released from several threads.
+ *
  * \note If you are moving to this template from the RefCountBase class,
  * you need to be careful to mark appropriately your destructor virtual
  * if needed. i.e., if your class has subclasses, _do_ mark your destructor
@@ -114,7 +122,11 @@ class SimpleRefCount : public PARENT
     inline void Ref() const
     {
         NS_ASSERT(m_count < std::numeric_limits<uint32_t>::max());
+#ifdef NS3_MTP
+        m_count.fetch_add(1, std::memory_order_relaxed);
+#else
         m_count++;
+#endif
     }
 
     /**
@@ -125,8 +137,12 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
+#ifdef NS3_MTP
+        if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+#else
         m_count--;
         if (m_count == 0)
+#endif
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -151,7 +167,11 @@ class SimpleRefCount : public PARENT
      * Note we make this mutable so that the const methods can still
      * change it.
      */
+#ifdef NS3_MTP
+    mutable std::atomic<uint32_t> m_count;
+#else
     mutable uint32_t m_count;
+#endif
 };
 
 } // namespace ns3
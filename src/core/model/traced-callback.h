@@ -142,7 +142,7 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    m_callbackList.push_back(std::move(cb));
 }
 
 template <typename... Ts>
@@ -155,7 +155,7 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    m_callbackList.push_back(std::move(realCb));
 }
 
 template <typename... Ts>
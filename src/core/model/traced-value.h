@@ -96,6 +96,101 @@ typedef void (*Void)();
 
 } // namespace TracedValueCallback
 
+/**
+ * \ingroup tracing
+ *
+ * \brief Policies of a TracedValue.
+ */
+namespace TracedValuePolicy
+{
+
+/** Invoke the connected callbacks when the value changes. */
+struct Traced
+{
+};
+
+/**
+ * Compile the TracedValue down to a plain value: the callbacks connected
+ * to it are ignored, and it has the size of its underlying value.
+ */
+struct Elided
+{
+};
+
+/**
+ * The policy of the trace sources which change on the hot paths of the
+ * models, such as the congestion state of TCP (see TcpSocketState).
+ * They are elided when ns-3 is configured with NS3_ELIDE_HOT_TRACES
+ * (--enable-elided-hot-traces), to remove the cost of tracing from
+ * simulations which do not need these trace sources.
+ */
+#ifdef NS3_ELIDE_HOT_TRACES
+typedef Elided Hot;
+#else
+typedef Traced Hot;
+#endif
+
+} // namespace TracedValuePolicy
+
+/**
+ * \ingroup tracing
+ *
+ * \brief The callbacks of a TracedValue with policy \p P.
+ *
+ * \tparam T \explicit The type of the underlying value.
+ * \tparam P \explicit The policy of the TracedValue.
+ */
+template <typename T, typename P>
+class TracedValueCallbacks : public TracedCallback<T, T>
+{
+};
+
+/**
+ * \ingroup tracing
+ *
+ * \brief The callbacks of an elided TracedValue: none.
+ *
+ * \tparam T \explicit The type of the underlying value.
+ */
+template <typename T>
+class TracedValueCallbacks<T, TracedValuePolicy::Elided>
+{
+  public:
+    /** Ignore a callback. */
+    void ConnectWithoutContext(const CallbackBase& /* cb */)
+    {
+    }
+
+    /** Ignore a callback. */
+    void Connect(const CallbackBase& /* cb */, std::string /* path */)
+    {
+    }
+
+    /** Ignore a callback. */
+    void DisconnectWithoutContext(const CallbackBase& /* cb */)
+    {
+    }
+
+    /** Ignore a callback. */
+    void Disconnect(const CallbackBase& /* cb */, std::string /* path */)
+    {
+    }
+
+    /** Do nothing. */
+    void operator()(const T& /* oldValue */, const T& /* newValue */) const
+    {
+    }
+
+    /** \return true: no callback is ever connected. */
+    constexpr bool IsEmpty() const
+    {
+        return true;
+    }
+};
+
+template <typename T, typename P = TracedValuePolicy::Traced>
+class TracedValue;
+
 /**
  * \ingroup tracing
  *
@@ -109,11 +204,21 @@ typedef void (*Void)();
  * and will define Connect/DisconnectWithoutContext methods to work
  * with MakeTraceSourceAccessor.
  *
+ * The policy \p P selects how the changes are reported:
+ * TracedValuePolicy::Traced, the default, invokes the connected
+ * callbacks, and skips the comparison of the old and new values when none
+ * is connected; TracedValuePolicy::Elided compiles the TracedValue down to
+ * a plain value of type \p T.
+ *
  * \tparam T \explicit The type of the underlying value being traced.
+ * \tparam P \explicit The policy, TracedValuePolicy::Traced by default.
  */
-template <typename T>
-class TracedValue
+template <typename T, typename P>
+class TracedValue : private TracedValueCallbacks<T, P>
 {
+    /** The connected callbacks. */
+    typedef TracedValueCallbacks<T, P> Callbacks;
+
   public:
     /** Default constructor. */
     TracedValue()
@@ -163,10 +268,11 @@ class TracedValue
     /**
      * Copy from a TracedValue of a compatible type.
      * \tparam U \deduced The underlying type of the other TracedValue.
+     * \tparam Q \deduced The policy of the other TracedValue.
      * \param [in] other The other TracedValuet to copy.
      */
-    template <typename U>
-    TracedValue(const TracedValue<U>& other)
+    template <typename U, typename Q>
+    TracedValue(const TracedValue<U, Q>& other)
         : m_v(other.Get())
     {
     }
@@ -182,6 +288,36 @@ class TracedValue
     {
     }
 
+    /**
+     * Assign from a TracedValue of a compatible type.
+     * \tparam U \deduced The underlying type of the other TracedValue.
+     * \tparam Q \deduced The policy of the other TracedValue.
+     * \param [in] other The other TracedValue to assign.
+     * \return This TracedValue.
+     */
+    template <typename U, typename Q>
+    TracedValue& operator=(const TracedValue<U, Q>& other)
+    {
+        TRACED_VALUE_DEBUG("x=");
+        Set(other.Get());
+        return *this;
+    }
+
+    /**
+     * Assign from a variable type compatible with this underlying type,
+     * without building a temporary TracedValue (and its list of callbacks).
+     * \tparam U \deduced Type of the other variable.
+     * \param [in] other The other variable to assign.
+     * \return This TracedValue.
+     */
+    template <typename U>
+    TracedValue& operator=(const U& other)
+    {
+        TRACED_VALUE_DEBUG("x=");
+        Set((T)other);
+        return *this;
+    }
+
     /**
      * Connect a Callback (without context.)
      *
@@ -189,7 +325,7 @@ class TracedValue
      */
     void ConnectWithoutContext(const CallbackBase& cb)
     {
-        m_cb.ConnectWithoutContext(cb);
+        Callbacks::ConnectWithoutContext(cb);
     }
 
     /**
@@ -203,7 +339,7 @@ class TracedValue
      */
     void Connect(const CallbackBase& cb, std::string path)
     {
-        m_cb.Connect(cb, path);
+        Callbacks::Connect(cb, path);
     }
 
     /**
@@ -213,7 +349,7 @@ class TracedValue
      */
     void DisconnectWithoutContext(const CallbackBase& cb)
     {
-        m_cb.DisconnectWithoutContext(cb);
+        Callbacks::DisconnectWithoutContext(cb);
     }
 
     /**
@@ -224,7 +360,7 @@ class TracedValue
      */
     void Disconnect(const CallbackBase& cb, std::string path)
     {
-        m_cb.Disconnect(cb, path);
+        Callbacks::Disconnect(cb, path);
     }
 
     /**
@@ -235,11 +371,11 @@ class TracedValue
      */
     void Set(const T& v)
     {
-        if (m_v != v)
+        if (!Callbacks::IsEmpty() && m_v != v)
         {
-            m_cb(m_v, v);
-            m_v = v;
+            Callbacks::operator()(m_v, v);
         }
+        m_v = v;
     }
 
     /**
@@ -301,8 +437,6 @@ class TracedValue
   private:
     /** The underlying value. */
     T m_v;
-    /** The connected Callback. */
-    TracedCallback<T, T> m_cb;
 };
 
 /********************************************************************
@@ -319,13 +453,14 @@ class TracedValue
  * The underlying value will be written to the stream.
  *
  * \tparam T \deduced The underlying type of the TracedValue.
+ * \tparam P \deduced The policy of the TracedValue.
  * \param [in,out] os The output stream.
  * \param [in] rhs The TracedValue to stream.
  * \returns The stream.
  */
-template <typename T>
+template <typename T, typename P>
 std::ostream&
-operator<<(std::ostream& os, const TracedValue<T>& rhs)
+operator<<(std::ostream& os, const TracedValue<T, P>& rhs)
 {
     return os << rhs.Get();
 }
@@ -333,167 +468,168 @@ operator<<(std::ostream& os, const TracedValue<T>& rhs)
 /**
  * Boolean operator for TracedValue.
  * \tparam T \deduced The underlying type held by the left-hand argument.
+ * \tparam P \deduced The policy of the left-hand argument.
  * \tparam U \deduced The underlying type held by the right-hand argument.
  * \param [in] lhs The left-hand argument.
  * \param [in] rhs The right-hand argument.
  * \returns The Boolean result of comparing the underlying values.
  */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 bool
-operator==(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
+operator==(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
 {
     TRACED_VALUE_DEBUG("x==x");
     return lhs.Get() == rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator==(const TracedValue<T>& lhs, const U& rhs)
+operator==(const TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x==");
     return lhs.Get() == rhs;
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator==(const U& lhs, const TracedValue<T>& rhs)
+operator==(const U& lhs, const TracedValue<T, P>& rhs)
 {
     TRACED_VALUE_DEBUG("==x");
     return lhs == rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 bool
-operator!=(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
+operator!=(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
 {
     TRACED_VALUE_DEBUG("x!=x");
     return lhs.Get() != rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator!=(const TracedValue<T>& lhs, const U& rhs)
+operator!=(const TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x!=");
     return lhs.Get() != rhs;
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator!=(const U& lhs, const TracedValue<T>& rhs)
+operator!=(const U& lhs, const TracedValue<T, P>& rhs)
 {
     TRACED_VALUE_DEBUG("!=x");
     return lhs != rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 bool
-operator<=(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
+operator<=(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
 {
     TRACED_VALUE_DEBUG("x<=x");
     return lhs.Get() <= rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator<=(const TracedValue<T>& lhs, const U& rhs)
+operator<=(const TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x<=");
     return lhs.Get() <= rhs;
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator<=(const U& lhs, const TracedValue<T>& rhs)
+operator<=(const U& lhs, const TracedValue<T, P>& rhs)
 {
     TRACED_VALUE_DEBUG("<=x");
     return lhs <= rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 bool
-operator>=(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
+operator>=(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
 {
     TRACED_VALUE_DEBUG("x>=x");
     return lhs.Get() >= rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator>=(const TracedValue<T>& lhs, const U& rhs)
+operator>=(const TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x>=");
     return lhs.Get() >= rhs;
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator>=(const U& lhs, const TracedValue<T>& rhs)
+operator>=(const U& lhs, const TracedValue<T, P>& rhs)
 {
     TRACED_VALUE_DEBUG(">=x");
     return lhs >= rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 bool
-operator<(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
+operator<(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
 {
     TRACED_VALUE_DEBUG("x<x");
     return lhs.Get() < rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator<(const TracedValue<T>& lhs, const U& rhs)
+operator<(const TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x<");
     return lhs.Get() < rhs;
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator<(const U& lhs, const TracedValue<T>& rhs)
+operator<(const U& lhs, const TracedValue<T, P>& rhs)
 {
     TRACED_VALUE_DEBUG("<x");
     return lhs < rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 bool
-operator>(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
+operator>(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
 {
     TRACED_VALUE_DEBUG("x>x");
     return lhs.Get() > rhs.Get();
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator>(const TracedValue<T>& lhs, const U& rhs)
+operator>(const TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x>");
     return lhs.Get() > rhs;
 }
 
 /** \copydoc operator==(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 bool
-operator>(const U& lhs, const TracedValue<T>& rhs)
+operator>(const U& lhs, const TracedValue<T, P>& rhs)
 {
     TRACED_VALUE_DEBUG(">x");
     return lhs > rhs.Get();
@@ -506,289 +642,290 @@ operator>(const U& lhs, const TracedValue<T>& rhs)
  * which has no Callback connected.
  *
  * \tparam T \deduced The underlying type held by the left-hand argument.
+ * \tparam P \deduced The policy of the left-hand argument.
  * \tparam U \deduced The underlying type held by the right-hand argument.
  * \param [in] lhs The left-hand argument.
  * \param [in] rhs The right-hand argument.
  * \returns The result of doing the operator on
  *     the underlying values.
  */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator+(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() + rhs.Get())>
+operator+(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() + rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x+x");
-    return TracedValue<decltype(lhs.Get() + rhs.Get())>(lhs.Get() + rhs.Get());
+    return TracedValue<decltype(lhs.Get() + rhs.Get()), P>(lhs.Get() + rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator+(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() + rhs)>
+operator+(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() + rhs), P>
 {
     TRACED_VALUE_DEBUG("x+");
-    return TracedValue<decltype(lhs.Get() + rhs)>(lhs.Get() + rhs);
+    return TracedValue<decltype(lhs.Get() + rhs), P>(lhs.Get() + rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator+(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs + rhs.Get())>
+operator+(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs + rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("+x");
-    return TracedValue<decltype(lhs + rhs.Get())>(lhs + rhs.Get());
+    return TracedValue<decltype(lhs + rhs.Get()), P>(lhs + rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator-(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() - rhs.Get())>
+operator-(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() - rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x-x");
-    return TracedValue<decltype(lhs.Get() - rhs.Get())>(lhs.Get() - rhs.Get());
+    return TracedValue<decltype(lhs.Get() - rhs.Get()), P>(lhs.Get() - rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator-(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() - rhs)>
+operator-(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() - rhs), P>
 {
     TRACED_VALUE_DEBUG("x-");
-    return TracedValue<decltype(lhs.Get() - rhs)>(lhs.Get() - rhs);
+    return TracedValue<decltype(lhs.Get() - rhs), P>(lhs.Get() - rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator-(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs - rhs.Get())>
+operator-(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs - rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("-x");
-    return TracedValue<decltype(lhs - rhs.Get())>(lhs - rhs.Get());
+    return TracedValue<decltype(lhs - rhs.Get()), P>(lhs - rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator*(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() * rhs.Get())>
+operator*(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() * rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x*x");
-    return TracedValue<decltype(lhs.Get() * rhs.Get())>(lhs.Get() * rhs.Get());
+    return TracedValue<decltype(lhs.Get() * rhs.Get()), P>(lhs.Get() * rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator*(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() * rhs)>
+operator*(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() * rhs), P>
 {
     TRACED_VALUE_DEBUG("x*");
-    return TracedValue<decltype(lhs.Get() * rhs)>(lhs.Get() * rhs);
+    return TracedValue<decltype(lhs.Get() * rhs), P>(lhs.Get() * rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator*(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs + rhs.Get())>
+operator*(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs + rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("*x");
-    return TracedValue<decltype(lhs + rhs.Get())>(lhs * rhs.Get());
+    return TracedValue<decltype(lhs + rhs.Get()), P>(lhs * rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator/(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() / rhs.Get())>
+operator/(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() / rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x/x");
-    return TracedValue<decltype(lhs.Get() / rhs.Get())>(lhs.Get() / rhs.Get());
+    return TracedValue<decltype(lhs.Get() / rhs.Get()), P>(lhs.Get() / rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator/(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() / rhs)>
+operator/(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() / rhs), P>
 {
     TRACED_VALUE_DEBUG("x/");
-    return TracedValue<decltype(lhs.Get() / rhs)>(lhs.Get() / rhs);
+    return TracedValue<decltype(lhs.Get() / rhs), P>(lhs.Get() / rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator/(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs / rhs.Get())>
+operator/(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs / rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("/x");
-    return TracedValue<decltype(lhs / rhs.Get())>(lhs / rhs.Get());
+    return TracedValue<decltype(lhs / rhs.Get()), P>(lhs / rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator%(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() % rhs.Get())>
+operator%(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() % rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x%x");
-    return TracedValue<decltype(lhs.Get() % rhs.Get())>(lhs.Get() % rhs.Get());
+    return TracedValue<decltype(lhs.Get() % rhs.Get()), P>(lhs.Get() % rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator%(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() % rhs)>
+operator%(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() % rhs), P>
 {
     TRACED_VALUE_DEBUG("x%");
-    return TracedValue<decltype(lhs.Get() % rhs)>(lhs.Get() % rhs);
+    return TracedValue<decltype(lhs.Get() % rhs), P>(lhs.Get() % rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator%(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs % rhs.Get())>
+operator%(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs % rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("%x");
-    return TracedValue<decltype(lhs % rhs.Get())>(lhs % rhs.Get());
+    return TracedValue<decltype(lhs % rhs.Get()), P>(lhs % rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator^(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() ^ rhs.Get())>
+operator^(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() ^ rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x^x");
-    return TracedValue<decltype(lhs.Get() ^ rhs.Get())>(lhs.Get() ^ rhs.Get());
+    return TracedValue<decltype(lhs.Get() ^ rhs.Get()), P>(lhs.Get() ^ rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator^(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() ^ rhs)>
+operator^(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() ^ rhs), P>
 {
     TRACED_VALUE_DEBUG("x^");
-    return TracedValue<decltype(lhs.Get() ^ rhs)>(lhs.Get() ^ rhs);
+    return TracedValue<decltype(lhs.Get() ^ rhs), P>(lhs.Get() ^ rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator^(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs ^ rhs.Get())>
+operator^(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs ^ rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("^x");
-    return TracedValue<decltype(lhs ^ rhs.Get())>(lhs ^ rhs.Get());
+    return TracedValue<decltype(lhs ^ rhs.Get()), P>(lhs ^ rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator|(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() | rhs.Get())>
+operator|(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() | rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x|x");
-    return TracedValue<decltype(lhs.Get() | rhs.Get())>(lhs.Get() | rhs.Get());
+    return TracedValue<decltype(lhs.Get() | rhs.Get()), P>(lhs.Get() | rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator|(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() | rhs)>
+operator|(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() | rhs), P>
 {
     TRACED_VALUE_DEBUG("x|");
-    return TracedValue<decltype(lhs.Get() | rhs)>(lhs.Get() | rhs);
+    return TracedValue<decltype(lhs.Get() | rhs), P>(lhs.Get() | rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator|(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs | rhs.Get())>
+operator|(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs | rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("|x");
-    return TracedValue<decltype(lhs | rhs.Get())>(lhs | rhs.Get());
+    return TracedValue<decltype(lhs | rhs.Get()), P>(lhs | rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator&(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() & rhs.Get())>
+operator&(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() & rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x&x");
-    return TracedValue<decltype(lhs.Get() & rhs.Get())>(lhs.Get() & rhs.Get());
+    return TracedValue<decltype(lhs.Get() & rhs.Get()), P>(lhs.Get() & rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator&(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() & rhs)>
+operator&(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() & rhs), P>
 {
     TRACED_VALUE_DEBUG("x&");
-    return TracedValue<decltype(lhs.Get() & rhs)>(lhs.Get() & rhs);
+    return TracedValue<decltype(lhs.Get() & rhs), P>(lhs.Get() & rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator&(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs & rhs.Get())>
+operator&(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs & rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("&x");
-    return TracedValue<decltype(lhs & rhs.Get())>(lhs & rhs.Get());
+    return TracedValue<decltype(lhs & rhs.Get()), P>(lhs & rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator<<(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() << rhs.Get())>
+operator<<(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() << rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x<<x");
-    return TracedValue<decltype(lhs.Get() << rhs.Get())>(lhs.Get() << rhs.Get());
+    return TracedValue<decltype(lhs.Get() << rhs.Get()), P>(lhs.Get() << rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator<<(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() << rhs)>
+operator<<(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() << rhs), P>
 {
     TRACED_VALUE_DEBUG("x<<");
-    return TracedValue<decltype(lhs.Get() << rhs)>(lhs.Get() << rhs);
+    return TracedValue<decltype(lhs.Get() << rhs), P>(lhs.Get() << rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator<<(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs << rhs.Get())>
+operator<<(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs << rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("<<x");
-    return TracedValue<decltype(lhs << rhs.Get())>(lhs << rhs.Get());
+    return TracedValue<decltype(lhs << rhs.Get()), P>(lhs << rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename Q, typename U>
 auto
-operator>>(const TracedValue<T>& lhs, const TracedValue<U>& rhs)
-    -> TracedValue<decltype(lhs.Get() >> rhs.Get())>
+operator>>(const TracedValue<T, P>& lhs, const TracedValue<U, Q>& rhs)
+    -> TracedValue<decltype(lhs.Get() >> rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG("x>>x");
-    return TracedValue<decltype(lhs.Get() >> rhs.Get())>(lhs.Get() >> rhs.Get());
+    return TracedValue<decltype(lhs.Get() >> rhs.Get()), P>(lhs.Get() >> rhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator>>(const TracedValue<T>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() >> rhs)>
+operator>>(const TracedValue<T, P>& lhs, const U& rhs) -> TracedValue<decltype(lhs.Get() >> rhs), P>
 {
     TRACED_VALUE_DEBUG("x>>");
-    return TracedValue<decltype(lhs.Get() >> rhs)>(lhs.Get() >> rhs);
+    return TracedValue<decltype(lhs.Get() >> rhs), P>(lhs.Get() >> rhs);
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs,const TracedValue<U>&rhs) */
-template <typename T, typename U>
+template <typename T, typename P, typename U>
 auto
-operator>>(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs >> rhs.Get())>
+operator>>(const U& lhs, const TracedValue<T, P>& rhs) -> TracedValue<decltype(lhs >> rhs.Get()), P>
 {
     TRACED_VALUE_DEBUG(">>x");
-    return TracedValue<decltype(lhs >> rhs.Get())>(lhs >> rhs.Get());
+    return TracedValue<decltype(lhs >> rhs.Get()), P>(lhs >> rhs.Get());
 }
 
 /**
@@ -799,15 +936,16 @@ operator>>(const U& lhs, const TracedValue<T>& rhs) -> TracedValue<decltype(lhs
  * is different, the Callback will be invoked.
  *
  * \tparam T \deduced The underlying type held by the left-hand argument.
+ * \tparam P \deduced The policy of the left-hand argument.
  * \tparam U \deduced The underlying type held by the right-hand argument.
  * \param [in] lhs The left-hand argument.
  * \param [in] rhs The right-hand argument.
  * \returns The result of doing the operator on
  *     the underlying values.
  */
-template <typename T, typename U>
-TracedValue<T>&
-operator+=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator+=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x+=");
     T tmp = lhs.Get();
@@ -817,9 +955,9 @@ operator+=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator-=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator-=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x-=");
     T tmp = lhs.Get();
@@ -829,9 +967,9 @@ operator-=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator*=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator*=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x*=");
     T tmp = lhs.Get();
@@ -841,9 +979,9 @@ operator*=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator/=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator/=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x/=");
     T tmp = lhs.Get();
@@ -853,9 +991,9 @@ operator/=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator%=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator%=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x%=");
     T tmp = lhs.Get();
@@ -865,9 +1003,9 @@ operator%=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator<<=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator<<=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x<<=");
     T tmp = lhs.Get();
@@ -877,9 +1015,9 @@ operator<<=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator>>=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator>>=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x>>=");
     T tmp = lhs.Get();
@@ -889,9 +1027,9 @@ operator>>=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator&=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator&=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x&=");
     T tmp = lhs.Get();
@@ -901,9 +1039,9 @@ operator&=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator|=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator|=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x|=");
     T tmp = lhs.Get();
@@ -913,9 +1051,9 @@ operator|=(TracedValue<T>& lhs, const U& rhs)
 }
 
 /** \copydoc operator+=(TracedValue<T>&lhs,const U&rhs) */
-template <typename T, typename U>
-TracedValue<T>&
-operator^=(TracedValue<T>& lhs, const U& rhs)
+template <typename T, typename P, typename U>
+TracedValue<T, P>&
+operator^=(TracedValue<T, P>& lhs, const U& rhs)
 {
     TRACED_VALUE_DEBUG("x^=");
     T tmp = lhs.Get();
@@ -928,43 +1066,44 @@ operator^=(TracedValue<T>& lhs, const U& rhs)
  * Unary arithmetic operator for TracedValue.
  *
  * \tparam T \deduced The underlying type held by the TracedValue.
+ * \tparam P \deduced The policy of the TracedValue.
  * \param [in] lhs The TracedValue.
  * \returns The result of doing the operator on
  *     the underlying values.
  */
-template <typename T>
-TracedValue<T>
-operator+(const TracedValue<T>& lhs)
+template <typename T, typename P>
+TracedValue<T, P>
+operator+(const TracedValue<T, P>& lhs)
 {
     TRACED_VALUE_DEBUG("(+x)");
-    return TracedValue<T>(+lhs.Get());
+    return TracedValue<T, P>(+lhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs) */
-template <typename T>
-TracedValue<T>
-operator-(const TracedValue<T>& lhs)
+template <typename T, typename P>
+TracedValue<T, P>
+operator-(const TracedValue<T, P>& lhs)
 {
     TRACED_VALUE_DEBUG("(-x)");
-    return TracedValue<T>(-lhs.Get());
+    return TracedValue<T, P>(-lhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs) */
-template <typename T>
-TracedValue<T>
-operator~(const TracedValue<T>& lhs)
+template <typename T, typename P>
+TracedValue<T, P>
+operator~(const TracedValue<T, P>& lhs)
 {
     TRACED_VALUE_DEBUG("(~x)");
-    return TracedValue<T>(~lhs.Get());
+    return TracedValue<T, P>(~lhs.Get());
 }
 
 /** \copydoc operator+(const TracedValue<T>&lhs) */
-template <typename T>
-TracedValue<T>
-operator!(const TracedValue<T>& lhs)
+template <typename T, typename P>
+TracedValue<T, P>
+operator!(const TracedValue<T, P>& lhs)
 {
     TRACED_VALUE_DEBUG("(!x)");
-    return TracedValue<T>(!lhs.Get());
+    return TracedValue<T, P>(!lhs.Get());
 }
 
 /**@}*/ // \ingroup tracing
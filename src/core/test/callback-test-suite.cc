@@ -16,7 +16,9 @@
  */
 
 #include "ns3/callback.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/test.h"
+#include "ns3/traced-callback.h"
 
 #include <stdint.h>
 
@@ -991,6 +993,159 @@ NullifyCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(target1.IsNull(), true, "Nullified Callback reports not IsNull()");
 }
 
+/**
+ * \ingroup callback-tests
+ *
+ * Check the callbacks stored inline, and their mixing with the callbacks
+ * stored in a CallbackImpl.
+ */
+class InlineCallbackTestCase : public TestCase
+{
+  public:
+    InlineCallbackTestCase();
+
+    /** A reference counted object bound to the callbacks. */
+    class Target : public SimpleRefCount<Target>
+    {
+      public:
+        /**
+         * Add to the sum.
+         * \param [in] value The value to add.
+         */
+        void Add(int value)
+        {
+            m_sum += value;
+        }
+
+        /**
+         * Add the product of two values to the sum.
+         * \param [in] a The first value.
+         * \param [in] b The second value.
+         * \return The new sum.
+         */
+        int AddProduct(int a, int b)
+        {
+            m_sum += a * b;
+            return m_sum;
+        }
+
+        /**
+         * Nullify the callback holding the only reference to this object,
+         * then add to the sum.
+         * \param [in] value The value to add.
+         */
+        void ClearAndAdd(int value)
+        {
+            m_holder->Nullify();
+            s_destroyedBeforeAdd = s_destroyed;
+            m_sum += value;
+        }
+
+        ~Target()
+        {
+            ++s_destroyed;
+        }
+
+        int m_sum{0};                           //!< The sum of the values
+        Callback<void, int>* m_holder{nullptr}; //!< The callback cleared by ClearAndAdd
+        static int s_destroyed;                 //!< The number of destroyed targets
+        static int s_destroyedBeforeAdd;        //!< s_destroyed in ClearAndAdd
+    };
+
+  private:
+    void DoRun() override;
+};
+
+int InlineCallbackTestCase::Target::s_destroyed = 0;
+int InlineCallbackTestCase::Target::s_destroyedBeforeAdd = 0;
+
+InlineCallbackTestCase::InlineCallbackTestCase()
+    : TestCase("Check the callbacks stored inline")
+{
+}
+
+void
+InlineCallbackTestCase::DoRun()
+{
+    Ptr<Target> target = Create<Target>();
+    Callback<void, int> cb = MakeCallback(&Target::Add, target);
+    NS_TEST_ASSERT_MSG_EQ(cb.GetImpl()->GetReferenceCount(),
+                          1,
+                          "A member function and a Ptr should be stored inline");
+    NS_TEST_EXPECT_MSG_EQ(target->GetReferenceCount(), 2, "The callback holds a reference");
+
+    // copies compare equal, and hold their own reference
+    Callback<void, int> copy = cb;
+    NS_TEST_EXPECT_MSG_EQ(target->GetReferenceCount(), 3, "The copy holds a reference");
+    NS_TEST_EXPECT_MSG_EQ(copy.IsEqual(cb), true, "The copy should be equal");
+    NS_TEST_EXPECT_MSG_EQ(MakeCallback(&Target::Add, target).IsEqual(cb),
+                          true,
+                          "The same member function and object should be equal");
+    NS_TEST_EXPECT_MSG_EQ(MakeCallback(&Target::Add, Create<Target>()).IsEqual(cb),
+                          false,
+                          "Another object should not be equal");
+    copy(2);
+    cb(3);
+    NS_TEST_EXPECT_MSG_EQ(target->m_sum, 5, "Both callbacks should call the target");
+
+    // moves leave the source null
+    Callback<void, int> moved = std::move(copy);
+    NS_TEST_EXPECT_MSG_EQ(copy.IsNull(), true, "The moved callback should be null");
+    NS_TEST_EXPECT_MSG_EQ(moved.IsNull(), false, "The callback should be moved");
+    NS_TEST_EXPECT_MSG_EQ(target->GetReferenceCount(), 3, "A move does not add a reference");
+    copy = moved;
+    moved = std::move(cb);
+    NS_TEST_EXPECT_MSG_EQ(target->GetReferenceCount(), 3, "Wrong reference count");
+    moved.Nullify();
+    copy.Nullify();
+    NS_TEST_EXPECT_MSG_EQ(target->GetReferenceCount(), 1, "The references should be released");
+
+    // an inline callback compares equal to its CallbackImpl, and is converted
+    // to one when it is bound
+    cb = MakeCallback(&Target::Add, target);
+    Callback<void, int> impl(DynamicCast<CallbackImpl<void, int>>(cb.GetImpl()));
+    NS_TEST_EXPECT_MSG_EQ(impl.IsEqual(cb), true, "The CallbackImpl should be equal");
+    NS_TEST_EXPECT_MSG_EQ(cb.IsEqual(impl), true, "The CallbackImpl should be equal");
+    target->m_sum = 0;
+    Callback<int, int> product = MakeCallback(&Target::AddProduct, target).Bind(10);
+    NS_TEST_EXPECT_MSG_EQ(product(4), 40, "The bound callback should return the new sum");
+
+    // trace sources connect, call and disconnect inline callbacks
+    TracedCallback<int> trace;
+    trace.ConnectWithoutContext(MakeCallback(&Target::Add, target));
+    trace.ConnectWithoutContext(impl);
+    trace(1);
+    NS_TEST_EXPECT_MSG_EQ(target->m_sum, 42, "Both callbacks should be called");
+    trace.DisconnectWithoutContext(MakeCallback(&Target::Add, target));
+    trace(1);
+    NS_TEST_EXPECT_MSG_EQ(target->m_sum, 42, "Both callbacks should be disconnected");
+
+    // the attribute value keeps the inline storage
+    CallbackValue value(cb);
+    Callback<void, int> fromValue;
+    NS_TEST_EXPECT_MSG_EQ(value.GetAccessor(fromValue), true, "Wrong callback type");
+    NS_TEST_EXPECT_MSG_EQ(fromValue.IsEqual(cb), true, "The callback should be copied");
+    Callback<void, double> wrongType;
+    NS_TEST_EXPECT_MSG_EQ(value.GetAccessor(wrongType), false, "The type should not match");
+
+    // a callback holding the only reference to its object can clear itself
+    // while it is called: the object lives until the call returns
+    Target::s_destroyed = 0;
+    Callback<void, int> self;
+    {
+        Ptr<Target> owned = Create<Target>();
+        owned->m_holder = &self;
+        self = MakeCallback(&Target::ClearAndAdd, owned);
+    }
+    NS_TEST_ASSERT_MSG_EQ(Target::s_destroyed, 0, "The callback should keep the object alive");
+    self(1);
+    NS_TEST_EXPECT_MSG_EQ(self.IsNull(), true, "The callback should have cleared itself");
+    NS_TEST_EXPECT_MSG_EQ(Target::s_destroyedBeforeAdd,
+                          0,
+                          "The object should live until the call returns");
+    NS_TEST_EXPECT_MSG_EQ(Target::s_destroyed, 1, "The object should be released after the call");
+}
+
 /**
  * \ingroup callback-tests
  *
@@ -1197,6 +1352,7 @@ CallbackTestSuite::CallbackTestSuite()
     AddTestCase(new MakeBoundCallbackTestCase, TestCase::QUICK);
     AddTestCase(new CallbackEqualityTestCase, TestCase::QUICK);
     AddTestCase(new NullifyCallbackTestCase, TestCase::QUICK);
+    AddTestCase(new InlineCallbackTestCase, TestCase::QUICK);
     AddTestCase(new MakeCallbackTemplatesTestCase, TestCase::QUICK);
 }
 
@@ -864,6 +864,170 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * Test Config::CompiledPath against the Config functions.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CompiledPathConfigTestCase();
+
+    /** Destructor. */
+    ~CompiledPathConfigTestCase() override
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that a compiled path matches the same objects as
+     * Config::LookupMatches.
+     *
+     * \param [in] path The path, without leaf.
+     */
+    void CheckMatches(std::string path);
+
+    /**
+     * Trace callback without context.
+     * \param oldValue The old value.
+     * \param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue)
+    {
+        m_count++;
+        m_newValue = newValue;
+    }
+
+    /**
+     * Trace callback with context path.
+     * \param path The context path.
+     * \param old The old value.
+     * \param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_count++;
+        m_newValue = newValue;
+        m_path = path;
+    }
+
+    uint32_t m_count;   //!< Number of trace calls.
+    int16_t m_newValue; //!< Flag to detect tracing result.
+    std::string m_path; //!< The context path.
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase()
+    : TestCase("Check that compiled paths match and connect as the Config functions")
+{
+}
+
+void
+CompiledPathConfigTestCase::CheckMatches(std::string path)
+{
+    Config::MatchContainer expected = Config::LookupMatches(path);
+    Config::MatchContainer matches = Config::CompiledPath(path + "/A").LookupMatches();
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), expected.GetN(), "Different matches for " << path);
+    for (std::size_t i = 0; i < matches.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(matches.Get(i), expected.Get(i), "Different object for " << path);
+        NS_TEST_EXPECT_MSG_EQ(matches.GetMatchedPath(i),
+                              expected.GetMatchedPath(i),
+                              "Different context for " << path);
+    }
+}
+
+void
+CompiledPathConfigTestCase::DoRun()
+{
+    IntegerValue iv;
+
+    //
+    // Create a root namespace object, with a vector of four objects
+    // two levels down.
+    //
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+    Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject>();
+    a->SetNodeB(b);
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objects.push_back(CreateObject<ConfigTestObject>());
+        b->AddNodeB(objects.back());
+    }
+    objects[1]->AggregateObject(CreateObject<DerivedConfigObject>());
+    Names::Add("Compiled", objects[2]);
+
+    CheckMatches("/NodeA/NodeB/NodesB/*");
+    CheckMatches("/NodeA/NodeB/NodesB/[1-2]|0");
+    CheckMatches("/NodeA/NodeB/NodesB/3|[0-1]|1");
+    CheckMatches("/NodeA/NodeB/NodesB/7");
+    CheckMatches("/NodeA/NodeB/NodesB/x");
+    CheckMatches("/*/*/NodesB/1/$DerivedConfigObject");
+    CheckMatches("/NodeA/*/*/*");
+    CheckMatches("/Names/Compiled");
+
+    //
+    // Set through a compiled path.
+    //
+    Config::CompiledPath set("/NodeA/NodeB/NodesB/[1-2]/A");
+    set.Set(IntegerValue(3));
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        int64_t expected = (i == 1 || i == 2) ? 3 : 10;
+        objects[i]->GetAttribute("A", iv);
+        NS_TEST_EXPECT_MSG_EQ(iv.Get(), expected, "Wrong value of " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(Config::CompiledPath("/NodeA/NodeB/NodesB/7/A").SetFailSafe(iv),
+                          false,
+                          "Set an attribute of a missing object");
+
+    //
+    // Connect one sink to all the matches, including an object added after
+    // the path is compiled.
+    //
+    Config::CompiledPath source("/NodeA/NodeB/NodesB/*/Source");
+    objects.push_back(CreateObject<ConfigTestObject>());
+    b->AddNodeB(objects.back());
+    source.ConnectWithoutContext(MakeCallback(&CompiledPathConfigTestCase::Trace, this));
+    m_count = 0;
+    for (uint32_t i = 0; i < objects.size(); i++)
+    {
+        objects[i]->SetAttribute("Source", IntegerValue(-2 - static_cast<int>(i)));
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_count, 5, "Trace did not fire for each object");
+    NS_TEST_EXPECT_MSG_EQ(m_newValue, -6, "Trace did not fire for the new object");
+    source.DisconnectWithoutContext(MakeCallback(&CompiledPathConfigTestCase::Trace, this));
+    m_count = 0;
+    objects[0]->SetAttribute("Source", IntegerValue(-10));
+    NS_TEST_EXPECT_MSG_EQ(m_count, 0, "Trace fired after disconnection");
+
+    //
+    // Connect with context.
+    //
+    Config::CompiledPath context("/NodeA/NodeB/NodesB/3|1/Source");
+    context.Connect(MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    m_count = 0;
+    objects[3]->SetAttribute("Source", IntegerValue(-4));
+    NS_TEST_EXPECT_MSG_EQ(m_count, 1, "Trace 3 did not fire as expected");
+    NS_TEST_EXPECT_MSG_EQ(m_path,
+                          "/NodeA/NodeB/NodesB/3/Source",
+                          "Trace 3 did not provide expected context");
+    objects[2]->SetAttribute("Source", IntegerValue(-3));
+    NS_TEST_EXPECT_MSG_EQ(m_count, 1, "Trace 2 fired unexpectedly");
+    context.Disconnect(MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    objects[1]->SetAttribute("Source", IntegerValue(-2));
+    NS_TEST_EXPECT_MSG_EQ(m_count, 1, "Trace fired after disconnection");
+
+    Names::Clear();
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -882,6 +1046,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new CompiledPathConfigTestCase);
 }
 
 /**
@@ -0,0 +1,158 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup randomvariable-tests
+ * Test for RandomVariableStream::GetValues.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup randomvariable-tests
+ * Check that RandomVariableStream::GetValues returns the same values as
+ * successive GetValue() calls, and leaves the stream in the same state.
+ */
+class GetValuesTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] name The name of the distribution.
+     * \param [in] factory The factory of the random variables.
+     */
+    GetValuesTestCase(std::string name, ObjectFactory factory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_factory; //!< The factory of the random variables
+};
+
+GetValuesTestCase::GetValuesTestCase(std::string name, ObjectFactory factory)
+    : TestCase("Check GetValues() against GetValue() for " + name),
+      m_factory(factory)
+{
+}
+
+void
+GetValuesTestCase::DoRun()
+{
+    m_factory.Set("Stream", IntegerValue(42));
+    Ptr<RandomVariableStream> sequential = m_factory.Create<RandomVariableStream>();
+    Ptr<RandomVariableStream> batch = m_factory.Create<RandomVariableStream>();
+
+    // Batches of several sizes, including sizes larger than the internal
+    // batches, with GetValue() calls in between
+    for (std::size_t n : {1, 7, 1000, 0, 2, 513})
+    {
+        std::vector<double> values(n);
+        batch->GetValues(values.data(), n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            double expected = sequential->GetValue();
+            NS_TEST_ASSERT_MSG_EQ(values[i], expected, "Different value " << i << " of " << n);
+        }
+        NS_TEST_ASSERT_MSG_EQ(batch->GetValue(),
+                              sequential->GetValue(),
+                              "Different value after a batch of " << n);
+    }
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * RandomVariableStream::GetValues test suite.
+ */
+class GetValuesTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    GetValuesTestSuite();
+
+  private:
+    /**
+     * Add the test cases of a distribution, with and without antithetic
+     * values.
+     *
+     * \param [in] name The name of the distribution.
+     * \param [in] factory The factory of the random variables.
+     */
+    void AddDistribution(std::string name, ObjectFactory factory);
+};
+
+GetValuesTestSuite::GetValuesTestSuite()
+    : TestSuite("random-variable-stream-get-values", UNIT)
+{
+    ObjectFactory factory;
+    factory.SetTypeId("ns3::UniformRandomVariable");
+    factory.Set("Min", DoubleValue(-3));
+    factory.Set("Max", DoubleValue(8));
+    AddDistribution("uniform", factory);
+
+    factory = ObjectFactory("ns3::ExponentialRandomVariable");
+    factory.Set("Mean", DoubleValue(2));
+    factory.Set("Bound", DoubleValue(3));
+    AddDistribution("exponential", factory);
+
+    factory = ObjectFactory("ns3::NormalRandomVariable");
+    factory.Set("Mean", DoubleValue(5));
+    factory.Set("Variance", DoubleValue(4));
+    factory.Set("Bound", DoubleValue(3));
+    AddDistribution("normal", factory);
+
+    factory = ObjectFactory("ns3::LogNormalRandomVariable");
+    factory.Set("Mu", DoubleValue(1));
+    factory.Set("Sigma", DoubleValue(0.5));
+    AddDistribution("log-normal", factory);
+
+    // Default implementation
+    factory = ObjectFactory("ns3::ParetoRandomVariable");
+    AddDistribution("Pareto", factory);
+}
+
+void
+GetValuesTestSuite::AddDistribution(std::string name, ObjectFactory factory)
+{
+    AddTestCase(new GetValuesTestCase(name, factory));
+    factory.Set("Antithetic", BooleanValue(true));
+    AddTestCase(new GetValuesTestCase("antithetic " + name, factory));
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * GetValuesTestSuite instance variable.
+ */
+static GetValuesTestSuite g_getValuesTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
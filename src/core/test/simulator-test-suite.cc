@@ -16,14 +16,24 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/boolean.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <set>
+#include <sstream>
+
 using namespace ns3;
 
 /**
@@ -221,6 +231,100 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the order of the events returned by a scheduler.
+ *
+ * Events are drawn from a mix of near-future and far-future times, and
+ * some are removed before they expire, as with packet transmissions and
+ * timers. The events removed from the scheduler are checked against a
+ * sorted reference set.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the order of the events of " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::set<Scheduler::Event> reference;
+    std::mt19937 rng(42);
+    uint32_t uid = 0;
+    uint64_t now = 0;
+
+    auto insert = [&]() {
+        uint64_t delay;
+        switch (rng() % 4)
+        {
+        case 0:
+            delay = rng() % 1000000000; // far-future timer
+            break;
+        case 1:
+            delay = 0; // same time
+            break;
+        default:
+            delay = rng() % 10000; // near-future transmission
+            break;
+        }
+        Scheduler::Event ev{nullptr, {now + delay, uid++, 0}};
+        scheduler->Insert(ev);
+        reference.insert(ev);
+    };
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        insert();
+    }
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), false, "Scheduler emptied too early");
+        Scheduler::Event next = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, reference.begin()->key.m_uid, "Wrong event order");
+        reference.erase(reference.begin());
+        now = next.key.m_ts;
+
+        insert();
+        if (rng() % 2)
+        {
+            insert();
+        }
+        if (rng() % 3 == 0 && !reference.empty())
+        {
+            // Cancel an event, either the next one or a later one
+            auto it = reference.begin();
+            std::advance(it, rng() % std::min<std::size_t>(reference.size(), 100));
+            scheduler->Remove(*it);
+            reference.erase(it);
+        }
+    }
+    while (!reference.empty())
+    {
+        Scheduler::Event next = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, reference.begin()->key.m_uid, "Wrong event order");
+        reference.erase(reference.begin());
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler not empty");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -717,6 +821,185 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that released events are reused by the EventImpl pool.
+ */
+class SimulatorEventPoolTestCase : public TestCase
+{
+  public:
+    SimulatorEventPoolTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Function used for scheduling.
+     * \param value The value added to m_sum.
+     */
+    void Add(uint64_t value);
+
+    uint64_t m_sum; //!< Sum of the values passed to Add()
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase()
+    : TestCase("Check the reuse of released events"),
+      m_sum(0)
+{
+}
+
+void
+SimulatorEventPoolTestCase::Add(uint64_t value)
+{
+    m_sum += value;
+}
+
+void
+SimulatorEventPoolTestCase::DoRun()
+{
+    bool wasEnabled = EventImpl::IsPoolEnabled();
+    EventImpl::SetPoolEnabled(true);
+
+    Ptr<EventImpl> event(MakeEvent(&SimulatorEventPoolTestCase::Add, this, 1), false);
+    EventImpl* released = PeekPointer(event);
+    event = nullptr;
+    event = Ptr<EventImpl>(MakeEvent(&SimulatorEventPoolTestCase::Add, this, 2), false);
+    NS_TEST_EXPECT_MSG_EQ(PeekPointer(event), released, "Released event not reused");
+    event->Invoke();
+    NS_TEST_EXPECT_MSG_EQ(m_sum, 2, "Reused event not invoked");
+    event = nullptr;
+
+    // Events flowing through the simulator, with the pool on and off
+    for (bool enabled : {true, false})
+    {
+        EventImpl::SetPoolEnabled(enabled);
+        m_sum = 0;
+        for (uint64_t i = 1; i <= 1000; ++i)
+        {
+            Simulator::Schedule(NanoSeconds(i % 7), &SimulatorEventPoolTestCase::Add, this, i);
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+        NS_TEST_EXPECT_MSG_EQ(m_sum, 500500, "Wrong sum with the pool enabled: " << enabled);
+    }
+
+    EventImpl::SetPoolEnabled(wasEnabled);
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the attribution of the wall-clock time to the event handlers,
+ * including virtual ones.
+ */
+class SimulatorEventProfileTestCase : public TestCase
+{
+  public:
+    SimulatorEventProfileTestCase();
+
+  private:
+    void DoRun() override;
+
+    // The handlers are virtual with the same signature, so that the profile
+    // has to tell them apart by their final overrider.
+
+    /** An expensive event handler. */
+    virtual void Heavy();
+    /** A cheap event handler. */
+    virtual void Light();
+
+    /**
+     * Record an event rate sample.
+     * \param now The simulation time of the sample.
+     * \param rate The event rate.
+     */
+    void Rate(Time now, double rate);
+
+    uint32_t m_samples; //!< Number of event rate samples
+};
+
+SimulatorEventProfileTestCase::SimulatorEventProfileTestCase()
+    : TestCase("Check the event handler profile"),
+      m_samples(0)
+{
+}
+
+void
+SimulatorEventProfileTestCase::Heavy()
+{
+    std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+void
+SimulatorEventProfileTestCase::Light()
+{
+}
+
+void
+SimulatorEventProfileTestCase::Rate(Time now, double rate)
+{
+    NS_TEST_EXPECT_MSG_GT(rate, 0, "No event at " << now);
+    m_samples++;
+}
+
+void
+SimulatorEventProfileTestCase::DoRun()
+{
+    Simulator::Destroy();
+    std::string file = CreateTempDirFilename("event-profile.txt");
+    Ptr<DefaultSimulatorImpl> impl = CreateObjectWithAttributes<DefaultSimulatorImpl>(
+        "EventProfile",
+        BooleanValue(true),
+        "EventProfileFile",
+        StringValue(file),
+        "EventRateInterval",
+        TimeValue(MilliSeconds(1)));
+    impl->TraceConnectWithoutContext("EventRate",
+                                     MakeCallback(&SimulatorEventProfileTestCase::Rate, this));
+    Simulator::SetImplementation(impl);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(MilliSeconds(i), &SimulatorEventProfileTestCase::Heavy, this);
+        for (uint32_t j = 0; j < 10; j++)
+        {
+            Simulator::ScheduleWithContext(j,
+                                           MilliSeconds(i),
+                                           &SimulatorEventProfileTestCase::Light,
+                                           this);
+        }
+    }
+    EventId cancelled =
+        Simulator::Schedule(Seconds(1), &SimulatorEventProfileTestCase::Heavy, this);
+    cancelled.Cancel();
+    Simulator::Run();
+
+    Simulator::Destroy();
+
+    std::ifstream is(file);
+    NS_TEST_ASSERT_MSG_EQ(is.is_open(), true, "Cannot open " << file);
+    std::ostringstream oss;
+    oss << is.rdbuf();
+    std::string report = oss.str();
+    NS_TEST_EXPECT_MSG_NE(report.find("110 events"), std::string::npos, report);
+    std::string::size_type pos = report.find("By handler:\n");
+    NS_TEST_ASSERT_MSG_NE(pos, std::string::npos, report);
+    std::string first = report.substr(pos, report.find('\n', pos + 12) - pos);
+    NS_TEST_EXPECT_MSG_NE(first.find("SimulatorEventProfileTestCase::Heavy()"),
+                          std::string::npos,
+                          "Heavy is not the most expensive handler: " << report);
+    NS_TEST_EXPECT_MSG_NE(first.find("    10 events"), std::string::npos, report);
+    NS_TEST_EXPECT_MSG_NE(report.find("SimulatorEventProfileTestCase::Light() [context 9]"),
+                          std::string::npos,
+                          report);
+    NS_TEST_EXPECT_MSG_EQ(m_samples, 9, "Wrong number of event rate samples");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -740,6 +1023,20 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+
+        for (const auto& tid : {MapScheduler::GetTypeId(),
+                                HeapScheduler::GetTypeId(),
+                                CalendarScheduler::GetTypeId(),
+                                PriorityQueueScheduler::GetTypeId(),
+                                LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(tid);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::QUICK);
+        }
+        AddTestCase(new SimulatorEventPoolTestCase(), TestCase::QUICK);
+        AddTestCase(new SimulatorEventProfileTestCase(), TestCase::QUICK);
     }
 };
 
@@ -30,6 +30,7 @@
 #include <list>
 #include <thread> // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -278,6 +279,80 @@ ThreadedSimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that the events scheduled from another thread run in the
+ * order of their insertion.
+ */
+class ThreadedSimulatorOrderTestCase : public TestCase
+{
+  public:
+    ThreadedSimulatorOrderTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Run a thread which schedules events, and wait for it. */
+    void StartThread();
+    /** Schedule the events, from another thread. */
+    void SchedulingThread();
+    /**
+     * Record the execution of an event.
+     * \param i The index of the event.
+     */
+    void Record(uint32_t i);
+
+    std::vector<uint32_t> m_order; //!< Indices of the executed events
+};
+
+ThreadedSimulatorOrderTestCase::ThreadedSimulatorOrderTestCase()
+    : TestCase("Check the order of the events scheduled from another thread")
+{
+}
+
+void
+ThreadedSimulatorOrderTestCase::StartThread()
+{
+    std::thread thread(&ThreadedSimulatorOrderTestCase::SchedulingThread, this);
+    thread.join();
+}
+
+void
+ThreadedSimulatorOrderTestCase::SchedulingThread()
+{
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        Simulator::ScheduleWithContext(i % 7,
+                                       MicroSeconds(i % 2),
+                                       &ThreadedSimulatorOrderTestCase::Record,
+                                       this,
+                                       i);
+    }
+}
+
+void
+ThreadedSimulatorOrderTestCase::Record(uint32_t i)
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), i % 7, "Wrong context");
+    m_order.push_back(i);
+}
+
+void
+ThreadedSimulatorOrderTestCase::DoRun()
+{
+    Simulator::Schedule(MicroSeconds(10), &ThreadedSimulatorOrderTestCase::StartThread, this);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_order.size(), 1000, "Missing events");
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_order[i], 2 * i, "Wrong order");
+        NS_TEST_EXPECT_MSG_EQ(m_order[500 + i], 2 * i + 1, "Wrong order");
+    }
+}
+
 /**
  * \ingroup threaded-tests
  *
@@ -292,6 +367,7 @@ class ThreadedSimulatorTestSuite : public TestSuite
         std::string simulatorTypes[] = {"ns3::RealtimeSimulatorImpl", "ns3::DefaultSimulatorImpl"};
         std::string schedulerTypes[] = {"ns3::ListScheduler",
                                         "ns3::HeapScheduler",
+                                        "ns3::LadderScheduler",
                                         "ns3::MapScheduler",
                                         "ns3::CalendarScheduler"};
         unsigned int threadCounts[] = {0, 2, 10, 20};
@@ -310,6 +386,7 @@ class ThreadedSimulatorTestSuite : public TestSuite
                 }
             }
         }
+        AddTestCase(new ThreadedSimulatorOrderTestCase(), TestCase::QUICK);
     }
 };
 
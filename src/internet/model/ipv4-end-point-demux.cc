@@ -24,6 +24,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -43,33 +45,128 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
     for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv4EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_ports.clear();
+    m_connected.clear();
+    m_wildcards.clear();
 }
 
 bool
-Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv4EndPointDemux::ConnectedKey::operator==(const ConnectedKey& other) const
 {
-    NS_LOG_FUNCTION(this << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return localPort == other.localPort && peerPort == other.peerPort &&
+           peerAddress == other.peerAddress;
+}
+
+size_t
+Ipv4EndPointDemux::ConnectedKeyHash::operator()(const ConnectedKey& key) const
+{
+    uint64_t ports = (static_cast<uint64_t>(key.localPort) << 16) | key.peerPort;
+    return std::hash<uint64_t>()((ports << 32) | key.peerAddress.Get());
+}
+
+bool
+Ipv4EndPointDemux::IsConnected(Ipv4Address peerAddress, uint16_t peerPort)
+{
+    return peerPort != 0 && peerAddress != Ipv4Address::GetAny();
+}
+
+const Ipv4EndPointDemux::EndPointBucket*
+Ipv4EndPointDemux::FindBucket(uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort) const
+{
+    if (IsConnected(peerAddress, peerPort))
     {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
+        auto it = m_connected.find(ConnectedKey{localPort, peerAddress, peerPort});
+        return it == m_connected.end() ? nullptr : &it->second;
+    }
+    auto it = m_wildcards.find(localPort);
+    return it == m_wildcards.end() ? nullptr : &it->second;
+}
+
+void
+Ipv4EndPointDemux::AddToIndex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_ports[endPoint->m_localPort].push_back(endPoint);
+    if (IsConnected(endPoint->m_peerAddr, endPoint->m_peerPort))
+    {
+        ConnectedKey key{endPoint->m_localPort, endPoint->m_peerAddr, endPoint->m_peerPort};
+        m_connected[key].push_back(endPoint);
+    }
+    else
+    {
+        m_wildcards[endPoint->m_localPort].push_back(endPoint);
+    }
+}
+
+/**
+ * \brief Remove an endpoint from a bucket of an index, and the bucket from the index if empty.
+ * \param index the index
+ * \param key the key of the bucket
+ * \param endPoint the endpoint to remove
+ */
+template <class Index, class Key>
+static void
+RemoveFromBucket(Index& index, const Key& key, Ipv4EndPoint* endPoint)
+{
+    auto it = index.find(key);
+    NS_ASSERT_MSG(it != index.end(), "Endpoint not indexed");
+    auto& bucket = it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), endPoint));
+    if (bucket.empty())
+    {
+        index.erase(it);
     }
-    return false;
+}
+
+void
+Ipv4EndPointDemux::RemoveFromIndex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    RemoveFromBucket(m_ports, endPoint->m_localPort, endPoint);
+    if (IsConnected(endPoint->m_peerAddr, endPoint->m_peerPort))
+    {
+        ConnectedKey key{endPoint->m_localPort, endPoint->m_peerAddr, endPoint->m_peerPort};
+        RemoveFromBucket(m_connected, key, endPoint);
+    }
+    else
+    {
+        RemoveFromBucket(m_wildcards, endPoint->m_localPort, endPoint);
+    }
+}
+
+void
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_endPoints.push_back(endPoint);
+    endPoint->m_demux = this;
+    AddToIndex(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_ports.find(port);
+    if (it == m_ports.end())
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        return false;
+    }
+    for (Ipv4EndPoint* endP : it->second)
+    {
+        if (endP->GetLocalAddress() == addr && endP->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -88,8 +185,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -104,8 +200,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -127,8 +222,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -140,21 +234,24 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // Only the endpoints sharing the index bucket can have the same local port and peer
+    const EndPointBucket* bucket = FindBucket(localPort, peerAddress, peerPort);
+    if (bucket != nullptr)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (Ipv4EndPoint* endP : *bucket)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetLocalPort() == localPort && endP->GetLocalAddress() == localAddress &&
+                endP->GetPeerPort() == peerPort && endP->GetPeerAddress() == peerAddress &&
+                (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
 
     return endPoint;
 }
@@ -167,6 +264,8 @@ Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
     {
         if (*i == endPoint)
         {
+            RemoveFromIndex(endPoint);
+            endPoint->m_demux = nullptr;
             delete endPoint;
             m_endPoints.erase(i);
             break;
@@ -191,171 +290,187 @@ Ipv4EndPointDemux::GetAllEndPoints()
     return ret;
 }
 
-/*
- * If we have an exact match, we return it.
- * Otherwise, if we find a generic match, we return it.
- * Otherwise, we return 0.
- */
-Ipv4EndPointDemux::EndPoints
-Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
-                          uint16_t dport,
-                          Ipv4Address saddr,
-                          uint16_t sport,
-                          Ptr<Ipv4Interface> incomingInterface)
+uint8_t
+Ipv4EndPointDemux::GetMatchLevel(Ipv4EndPoint* endP,
+                                 Ipv4Address daddr,
+                                 uint16_t dport,
+                                 Ipv4Address saddr,
+                                 uint16_t sport,
+                                 Ptr<Ipv4Interface> incomingInterface)
 {
-    NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; // Matches exact on local port, wildcards on others
-    EndPoints retval2; // Matches exact on local port/adder, wildcards on others
-    EndPoints retval3; // Matches all but local address
-    EndPoints retval4; // Exact match on all 4
+    NS_LOG_DEBUG("Looking at endpoint dport="
+                 << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                 << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
 
-    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    if (!endP->IsRxEnabled())
     {
-        Ipv4EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
+        NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint can not receive packets");
+        return 0;
+    }
 
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-        if (endP->GetBoundNetDevice())
+    if (endP->GetLocalPort() != dport)
+    {
+        NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                          << endP->GetLocalPort()
+                                          << " does not match packet dport " << dport);
+        return 0;
+    }
+    if (endP->GetBoundNetDevice())
+    {
+        if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
         {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
-            {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
-            }
+            NS_LOG_LOGIC("Skipping endpoint "
+                         << &endP << " because endpoint is bound to specific device and"
+                         << endP->GetBoundNetDevice() << " does not match packet device "
+                         << incomingInterface->GetDevice());
+            return 0;
         }
+    }
 
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
+    bool localAddressMatchesExact = false;
+    bool localAddressIsAny = false;
+    bool localAddressIsSubnetAny = false;
 
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
+    // We have 3 cases:
+    // 1) Exact local / destination address match
+    // 2) Local endpoint bound to Any -> matches anything
+    // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
+    // x.y.z.255 in a /24 net) and direct destination match.
 
-        if (endP->GetLocalAddress() == daddr)
-        {
-            // Case 1:
-            localAddressMatchesExact = true;
-        }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
-        }
-        else
+    if (endP->GetLocalAddress() == daddr)
+    {
+        // Case 1:
+        localAddressMatchesExact = true;
+    }
+    else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
+    {
+        // Case 2:
+        localAddressIsAny = true;
+    }
+    else
+    {
+        // Case 3:
+        for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
         {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+
+            Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+            if (endP->GetLocalAddress() == addrNetpart)
             {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+                NS_LOG_LOGIC("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress() << "/"
+                                                              << addr.GetMask().GetPrefixLength());
 
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
+                Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
+                if (addrNetpart == daddrNetPart)
                 {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
-
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
-                    {
-                        localAddressIsSubnetAny = true;
-                    }
+                    localAddressIsSubnetAny = true;
                 }
             }
-
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
-            {
-                continue;
-            }
         }
 
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+        // if no match here, keep looking
+        if (!localAddressIsSubnetAny)
         {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
-
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
-
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
+            return 0;
         }
     }
 
-    // Here we find the most exact match
-    EndPoints retval;
-    if (!retval4.empty())
+    bool remotePortMatchesExact = endP->GetPeerPort() == sport;
+    bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
+    bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+    bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
+
+    // If remote does not match either with exact or wildcard,
+    // skip this one
+    if (!(remotePortMatchesExact || remotePortMatchesWildCard))
     {
-        retval = retval4;
+        return 0;
     }
-    else if (!retval3.empty())
+    if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
     {
-        retval = retval3;
+        return 0;
     }
-    else if (!retval2.empty())
+
+    bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+
+    if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+    { // All 4 match - this is the case of an open TCP connection, for example.
+        NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        return 4;
+    }
+    if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+    { // All but local address - no idea what this case could be.
+        NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        return 3;
+    }
+    if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+    { // Only local port and local address matches exactly - Not yet opened connection
+        NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        return 2;
+    }
+    if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+    { // Only local port matches exactly - Endpoint open to "any" connection
+        NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * If we have an exact match, we return it.
+ * Otherwise, if we find a generic match, we return it.
+ * Otherwise, we return 0.
+ */
+Ipv4EndPointDemux::EndPoints
+Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
+                          uint16_t dport,
+                          Ipv4Address saddr,
+                          uint16_t sport,
+                          Ptr<Ipv4Interface> incomingInterface)
+{
+    NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
+
+    EndPoints retval; // Matches with the highest level found so far
+    uint8_t retvalLevel = 0;
+
+    auto consider = [&](const EndPointBucket& bucket) {
+        for (Ipv4EndPoint* endP : bucket)
+        {
+            uint8_t level = GetMatchLevel(endP, daddr, dport, saddr, sport, incomingInterface);
+            if (level == 0 || level < retvalLevel)
+            {
+                continue;
+            }
+            if (level > retvalLevel)
+            {
+                retval.clear();
+                retvalLevel = level;
+            }
+            retval.push_back(endP);
+        }
+    };
+
+    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
+
+    // Connected endpoints can only match on all 4 or all but local address.
+    // If one of them matches, the source is fully specified, and the
+    // endpoints with a wildcard peer can not match as well.
+    auto connected = m_connected.find(ConnectedKey{dport, saddr, sport});
+    if (connected != m_connected.end())
     {
-        retval = retval2;
+        consider(connected->second);
     }
-    else
+    if (retval.empty())
     {
-        retval = retval1;
+        auto wildcards = m_wildcards.find(dport);
+        if (wildcards != m_wildcards.end())
+        {
+            consider(wildcards->second);
+        }
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -372,34 +487,52 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    if (IsConnected(saddr, sport))
+    {
+        auto connected = m_connected.find(ConnectedKey{dport, saddr, sport});
+        if (connected != m_connected.end())
+        {
+            for (Ipv4EndPoint* endP : connected->second)
+            {
+                if (endP->GetLocalAddress() == daddr)
+                {
+                    /* this is an exact match. */
+                    return endP;
+                }
+            }
+        }
+    }
+
+    auto ports = m_ports.find(dport);
+    if (ports == m_ports.end())
+    {
+        return nullptr;
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
     uint32_t genericity = 3;
     Ipv4EndPoint* generic = nullptr;
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (Ipv4EndPoint* endP : ports->second)
     {
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
-        if ((*i)->GetLocalAddress() == daddr && (*i)->GetPeerPort() == sport &&
-            (*i)->GetPeerAddress() == saddr)
+        if (endP->GetLocalAddress() == daddr && endP->GetPeerPort() == sport &&
+            endP->GetPeerAddress() == saddr)
         {
             /* this is an exact match. */
-            return *i;
+            return endP;
         }
         uint32_t tmp = 0;
-        if ((*i)->GetLocalAddress() == Ipv4Address::GetAny())
+        if (endP->GetLocalAddress() == Ipv4Address::GetAny())
         {
             tmp++;
         }
-        if ((*i)->GetPeerAddress() == Ipv4Address::GetAny())
+        if (endP->GetPeerAddress() == Ipv4Address::GetAny())
         {
             tmp++;
         }
         if (tmp < genericity)
         {
-            generic = (*i);
+            generic = endP;
             genericity = tmp;
         }
     }
@@ -26,6 +26,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -42,6 +44,16 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * To keep the per-packet lookup cost independent of the number of sockets,
+ * the endpoints are also indexed in hash tables:
+ *   - endpoints with a fully specified peer (connected sockets) are indexed by
+ *     (local port, peer address, peer port);
+ *   - all the other endpoints (e.g., listening sockets) are indexed by local port,
+ *     and act as the wildcard fallback of the connected table.
+ *
+ * The endpoints notify the demux when their peer changes, so that the index
+ * is kept up to date.
  */
 
 class Ipv4EndPointDemux
@@ -171,6 +183,108 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * \brief Container of the endpoints sharing the same index key.
+     */
+    typedef std::vector<Ipv4EndPoint*> EndPointBucket;
+
+    /**
+     * \brief Index key of a connected endpoint.
+     */
+    struct ConnectedKey
+    {
+        uint16_t localPort;      //!< Local port
+        Ipv4Address peerAddress; //!< Peer address
+        uint16_t peerPort;       //!< Peer port
+
+        /**
+         * \brief Comparison operator
+         * \param other the key to compare to
+         * \return true if the keys are equal
+         */
+        bool operator==(const ConnectedKey& other) const;
+    };
+
+    /**
+     * \brief Hash function of a ConnectedKey.
+     */
+    struct ConnectedKeyHash
+    {
+        /**
+         * \brief Returns the hash of a ConnectedKey.
+         * \param key the key
+         * \return the hash
+         */
+        size_t operator()(const ConnectedKey& key) const;
+    };
+
+    /**
+     * \brief Check if a peer is fully specified.
+     * \param peerAddress peer address
+     * \param peerPort peer port
+     * \return true if neither the peer address nor the peer port are wildcards
+     */
+    static bool IsConnected(Ipv4Address peerAddress, uint16_t peerPort);
+
+    /**
+     * \brief Get the index bucket an endpoint with the given values belongs to.
+     * \param localPort local port
+     * \param peerAddress peer address
+     * \param peerPort peer port
+     * \return the bucket, or nullptr if it does not exist
+     */
+    const EndPointBucket* FindBucket(uint16_t localPort,
+                                     Ipv4Address peerAddress,
+                                     uint16_t peerPort) const;
+
+    /**
+     * \brief Add an endpoint to the lookup index.
+     * \param endPoint the endpoint
+     */
+    void AddToIndex(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Remove an endpoint from the lookup index.
+     *
+     * It must be called before changing any of the indexed endpoint values.
+     *
+     * \param endPoint the endpoint
+     */
+    void RemoveFromIndex(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Add a newly allocated endpoint to the demux.
+     * \param endPoint the endpoint
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Evaluate how well an endpoint matches a received packet.
+     *
+     * The returned values follow the order used by Lookup:
+     *   - 4: full match
+     *   - 3: all but local address
+     *   - 2: only local port and local address match
+     *   - 1: only local port match
+     *   - 0: no match
+     *
+     * \param endP the endpoint
+     * \param daddr destination address to test
+     * \param dport destination port to test
+     * \param saddr source address to test
+     * \param sport source port to test
+     * \param incomingInterface the incoming interface
+     * \return the match level
+     */
+    uint8_t GetMatchLevel(Ipv4EndPoint* endP,
+                          Ipv4Address daddr,
+                          uint16_t dport,
+                          Ipv4Address saddr,
+                          uint16_t sport,
+                          Ptr<Ipv4Interface> incomingInterface);
+
     /**
      * \brief Allocate an ephemeral port.
      * \returns the ephemeral port
@@ -196,6 +310,21 @@ class Ipv4EndPointDemux
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief All the IPv4 end points, indexed by local port.
+     */
+    std::unordered_map<uint16_t, EndPointBucket> m_ports;
+
+    /**
+     * \brief The IPv4 end points with a fully specified peer.
+     */
+    std::unordered_map<ConnectedKey, EndPointBucket, ConnectedKeyHash> m_connected;
+
+    /**
+     * \brief The IPv4 end points with a wildcard peer address or port, indexed by local port.
+     */
+    std::unordered_map<uint16_t, EndPointBucket> m_wildcards;
 };
 
 } // namespace ns3
@@ -33,6 +33,7 @@ namespace ns3
 
 class Header;
 class Packet;
+class Ipv4EndPointDemux;
 
 /**
  * \ingroup ipv4
@@ -190,6 +191,8 @@ class Ipv4EndPoint
     bool IsRxEnabled();
 
   private:
+    friend class Ipv4EndPointDemux;
+
     /**
      * \brief The local address.
      */
@@ -234,6 +237,11 @@ class Ipv4EndPoint
      * \brief true if the endpoint can receive packets.
      */
     bool m_rxEnabled;
+
+    /**
+     * \brief The demux indexing this endpoint (if any).
+     */
+    Ipv4EndPointDemux* m_demux;
 };
 
 } // namespace ns3
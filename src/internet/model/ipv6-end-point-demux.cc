@@ -23,6 +23,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -42,33 +44,128 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
     for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv6EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_ports.clear();
+    m_connected.clear();
+    m_wildcards.clear();
 }
 
 bool
-Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv6EndPointDemux::ConnectedKey::operator==(const ConnectedKey& other) const
 {
-    NS_LOG_FUNCTION(this << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return localPort == other.localPort && peerPort == other.peerPort &&
+           peerAddress == other.peerAddress;
+}
+
+size_t
+Ipv6EndPointDemux::ConnectedKeyHash::operator()(const ConnectedKey& key) const
+{
+    uint32_t ports = (static_cast<uint32_t>(key.localPort) << 16) | key.peerPort;
+    return Ipv6AddressHash()(key.peerAddress) ^ std::hash<uint32_t>()(ports);
+}
+
+bool
+Ipv6EndPointDemux::IsConnected(Ipv6Address peerAddress, uint16_t peerPort)
+{
+    return peerPort != 0 && peerAddress != Ipv6Address::GetAny();
+}
+
+const Ipv6EndPointDemux::EndPointBucket*
+Ipv6EndPointDemux::FindBucket(uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort) const
+{
+    if (IsConnected(peerAddress, peerPort))
     {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
+        auto it = m_connected.find(ConnectedKey{localPort, peerAddress, peerPort});
+        return it == m_connected.end() ? nullptr : &it->second;
+    }
+    auto it = m_wildcards.find(localPort);
+    return it == m_wildcards.end() ? nullptr : &it->second;
+}
+
+void
+Ipv6EndPointDemux::AddToIndex(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_ports[endPoint->m_localPort].push_back(endPoint);
+    if (IsConnected(endPoint->m_peerAddr, endPoint->m_peerPort))
+    {
+        ConnectedKey key{endPoint->m_localPort, endPoint->m_peerAddr, endPoint->m_peerPort};
+        m_connected[key].push_back(endPoint);
+    }
+    else
+    {
+        m_wildcards[endPoint->m_localPort].push_back(endPoint);
     }
-    return false;
+}
+
+/**
+ * \brief Remove an endpoint from a bucket of an index, and the bucket from the index if empty.
+ * \param index the index
+ * \param key the key of the bucket
+ * \param endPoint the endpoint to remove
+ */
+template <class Index, class Key>
+static void
+RemoveFromBucket(Index& index, const Key& key, Ipv6EndPoint* endPoint)
+{
+    auto it = index.find(key);
+    NS_ASSERT_MSG(it != index.end(), "Endpoint not indexed");
+    auto& bucket = it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), endPoint));
+    if (bucket.empty())
+    {
+        index.erase(it);
+    }
+}
+
+void
+Ipv6EndPointDemux::RemoveFromIndex(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    RemoveFromBucket(m_ports, endPoint->m_localPort, endPoint);
+    if (IsConnected(endPoint->m_peerAddr, endPoint->m_peerPort))
+    {
+        ConnectedKey key{endPoint->m_localPort, endPoint->m_peerAddr, endPoint->m_peerPort};
+        RemoveFromBucket(m_connected, key, endPoint);
+    }
+    else
+    {
+        RemoveFromBucket(m_wildcards, endPoint->m_localPort, endPoint);
+    }
+}
+
+void
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_endPoints.push_back(endPoint);
+    endPoint->m_demux = this;
+    AddToIndex(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+}
+
+bool
+Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_ports.find(port);
+    if (it == m_ports.end())
+    {
+        return false;
+    }
+    for (Ipv6EndPoint* endP : it->second)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        if (endP->GetLocalAddress() == addr && endP->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -87,8 +184,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -103,8 +199,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -126,8 +221,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -139,21 +233,24 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // Only the endpoints sharing the index bucket can have the same local port and peer
+    const EndPointBucket* bucket = FindBucket(localPort, peerAddress, peerPort);
+    if (bucket != nullptr)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (Ipv6EndPoint* endP : *bucket)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetLocalPort() == localPort && endP->GetLocalAddress() == localAddress &&
+                endP->GetPeerPort() == peerPort && endP->GetPeerAddress() == peerAddress &&
+                (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
 
     return endPoint;
 }
@@ -166,6 +263,8 @@ Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
     {
         if (*i == endPoint)
         {
+            RemoveFromIndex(endPoint);
+            endPoint->m_demux = nullptr;
             delete endPoint;
             m_endPoints.erase(i);
             break;
@@ -173,6 +272,97 @@ Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
     }
 }
 
+uint8_t
+Ipv6EndPointDemux::GetMatchLevel(Ipv6EndPoint* endP,
+                                 Ipv6Address daddr,
+                                 uint16_t dport,
+                                 Ipv6Address saddr,
+                                 uint16_t sport,
+                                 Ptr<Ipv6Interface> incomingInterface)
+{
+    NS_LOG_DEBUG("Looking at endpoint dport="
+                 << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                 << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
+
+    if (!endP->IsRxEnabled())
+    {
+        NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint can not receive packets");
+        return 0;
+    }
+
+    if (endP->GetLocalPort() != dport)
+    {
+        NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                          << endP->GetLocalPort()
+                                          << " does not match packet dport " << dport);
+        return 0;
+    }
+
+    if (endP->GetBoundNetDevice())
+    {
+        if (!incomingInterface)
+        {
+            return 0;
+        }
+        if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+        {
+            NS_LOG_LOGIC("Skipping endpoint "
+                         << &endP << " because endpoint is bound to specific device and"
+                         << endP->GetBoundNetDevice() << " does not match packet device "
+                         << incomingInterface->GetDevice());
+            return 0;
+        }
+    }
+
+    NS_LOG_DEBUG("dest addr " << daddr);
+
+    bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
+    bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
+    bool localAddressMatchesAllRouters =
+        endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
+
+    /* if no match here, keep looking */
+    if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+    {
+        return 0;
+    }
+    bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
+    bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
+    bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+    bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
+
+    /* If remote does not match either with exact or wildcard,
+       skip this one */
+    if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+    {
+        return 0;
+    }
+    if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+    {
+        return 0;
+    }
+
+    /* Now figure out which level this one matches at, most exact first */
+    if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
+    { /* All 4 match */
+        return 4;
+    }
+    if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
+    { /* All but local address */
+        return 3;
+    }
+    if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
+        remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
+    { /* Only local port and local address matches exactly */
+        return 2;
+    }
+    if (localAddressMatchesWildCard && remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
+    { /* Only local port matches exactly */
+        return 1;
+    }
+    return 0;
+}
+
 /*
  * If we have an exact match, we return it.
  * Otherwise, if we find a generic match, we return it.
@@ -187,118 +377,43 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
 
-    EndPoints retval1; /* Matches exact on local port, wildcards on others */
-    EndPoints retval2; /* Matches exact on local port/adder, wildcards on others */
-    EndPoints retval3; /* Matches all but local address */
-    EndPoints retval4; /* Exact match on all 4 */
+    EndPoints retval; /* Matches with the highest level found so far */
+    uint8_t retvalLevel = 0;
 
-    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv6EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
+    auto consider = [&](const EndPointBucket& bucket) {
+        for (Ipv6EndPoint* endP : bucket)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-
-        if (endP->GetBoundNetDevice())
-        {
-            if (!incomingInterface)
+            uint8_t level = GetMatchLevel(endP, daddr, dport, saddr, sport, incomingInterface);
+            if (level == 0 || level < retvalLevel)
             {
                 continue;
             }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            if (level > retvalLevel)
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
+                retval.clear();
+                retvalLevel = level;
             }
+            retval.push_back(endP);
         }
+    };
 
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
-
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
-
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
-
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
-        }
-    }
+    NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
 
-    // Here we find the most exact match
-    EndPoints retval;
-    if (!retval4.empty())
+    /* Connected endpoints can only match on all 4 or all but local address.
+       If one of them matches, the source is fully specified, and the
+       endpoints with a wildcard peer can not match as well. */
+    auto connected = m_connected.find(ConnectedKey{dport, saddr, sport});
+    if (connected != m_connected.end())
     {
-        retval = retval4;
+        consider(connected->second);
     }
-    else if (!retval3.empty())
+    if (retval.empty())
     {
-        retval = retval3;
-    }
-    else if (!retval2.empty())
-    {
-        retval = retval2;
-    }
-    else
-    {
-        retval = retval1;
+        auto wildcards = m_wildcards.find(dport);
+        if (wildcards != m_wildcards.end())
+        {
+            consider(wildcards->second);
+        }
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -310,38 +425,55 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    if (IsConnected(src, sport))
+    {
+        auto connected = m_connected.find(ConnectedKey{dport, src, sport});
+        if (connected != m_connected.end())
+        {
+            for (Ipv6EndPoint* endP : connected->second)
+            {
+                if (endP->GetLocalAddress() == dst)
+                {
+                    /* this is an exact match. */
+                    return endP;
+                }
+            }
+        }
+    }
+
+    auto ports = m_ports.find(dport);
+    if (ports == m_ports.end())
+    {
+        return nullptr;
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (Ipv6EndPoint* endP : ports->second)
     {
         uint32_t tmp = 0;
 
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
-
-        if ((*i)->GetLocalAddress() == dst && (*i)->GetPeerPort() == sport &&
-            (*i)->GetPeerAddress() == src)
+        if (endP->GetLocalAddress() == dst && endP->GetPeerPort() == sport &&
+            endP->GetPeerAddress() == src)
         {
             /* this is an exact match. */
-            return *i;
+            return endP;
         }
 
-        if ((*i)->GetLocalAddress() == Ipv6Address::GetAny())
+        if (endP->GetLocalAddress() == Ipv6Address::GetAny())
         {
             tmp++;
         }
 
-        if ((*i)->GetPeerAddress() == Ipv6Address::GetAny())
+        if (endP->GetPeerAddress() == Ipv6Address::GetAny())
         {
             tmp++;
         }
 
         if (tmp < genericity)
         {
-            generic = (*i);
+            generic = endP;
             genericity = tmp;
         }
     }
@@ -26,6 +26,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -36,6 +38,10 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * As in Ipv4EndPointDemux, the endpoints are indexed in hash tables, by
+ * (local port, peer address, peer port) for the endpoints with a fully
+ * specified peer, and by local port for the others.
  */
 class Ipv6EndPointDemux
 {
@@ -161,6 +167,108 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * \brief Container of the endpoints sharing the same index key.
+     */
+    typedef std::vector<Ipv6EndPoint*> EndPointBucket;
+
+    /**
+     * \brief Index key of a connected endpoint.
+     */
+    struct ConnectedKey
+    {
+        uint16_t localPort;      //!< Local port
+        Ipv6Address peerAddress; //!< Peer address
+        uint16_t peerPort;       //!< Peer port
+
+        /**
+         * \brief Comparison operator
+         * \param other the key to compare to
+         * \return true if the keys are equal
+         */
+        bool operator==(const ConnectedKey& other) const;
+    };
+
+    /**
+     * \brief Hash function of a ConnectedKey.
+     */
+    struct ConnectedKeyHash
+    {
+        /**
+         * \brief Returns the hash of a ConnectedKey.
+         * \param key the key
+         * \return the hash
+         */
+        size_t operator()(const ConnectedKey& key) const;
+    };
+
+    /**
+     * \brief Check if a peer is fully specified.
+     * \param peerAddress peer address
+     * \param peerPort peer port
+     * \return true if neither the peer address nor the peer port are wildcards
+     */
+    static bool IsConnected(Ipv6Address peerAddress, uint16_t peerPort);
+
+    /**
+     * \brief Get the index bucket an endpoint with the given values belongs to.
+     * \param localPort local port
+     * \param peerAddress peer address
+     * \param peerPort peer port
+     * \return the bucket, or nullptr if it does not exist
+     */
+    const EndPointBucket* FindBucket(uint16_t localPort,
+                                     Ipv6Address peerAddress,
+                                     uint16_t peerPort) const;
+
+    /**
+     * \brief Add an endpoint to the lookup index.
+     * \param endPoint the endpoint
+     */
+    void AddToIndex(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Remove an endpoint from the lookup index.
+     *
+     * It must be called before changing any of the indexed endpoint values.
+     *
+     * \param endPoint the endpoint
+     */
+    void RemoveFromIndex(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Add a newly allocated endpoint to the demux.
+     * \param endPoint the endpoint
+     */
+    void Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Evaluate how well an endpoint matches a received packet.
+     *
+     * The returned values follow the order used by Lookup:
+     *   - 4: full match
+     *   - 3: all but local address
+     *   - 2: only local port and local address match
+     *   - 1: only local port match
+     *   - 0: no match
+     *
+     * \param endP the endpoint
+     * \param daddr destination address to test
+     * \param dport destination port to test
+     * \param saddr source address to test
+     * \param sport source port to test
+     * \param incomingInterface the incoming interface
+     * \return the match level
+     */
+    uint8_t GetMatchLevel(Ipv6EndPoint* endP,
+                          Ipv6Address daddr,
+                          uint16_t dport,
+                          Ipv6Address saddr,
+                          uint16_t sport,
+                          Ptr<Ipv6Interface> incomingInterface);
+
     /**
      * \brief Allocate a ephemeral port.
      * \return a port
@@ -186,6 +294,21 @@ class Ipv6EndPointDemux
      * \brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief All the IPv6 end points, indexed by local port.
+     */
+    std::unordered_map<uint16_t, EndPointBucket> m_ports;
+
+    /**
+     * \brief The IPv6 end points with a fully specified peer.
+     */
+    std::unordered_map<ConnectedKey, EndPointBucket, ConnectedKeyHash> m_connected;
+
+    /**
+     * \brief The IPv6 end points with a wildcard peer address or port, indexed by local port.
+     */
+    std::unordered_map<uint16_t, EndPointBucket> m_wildcards;
 };
 
 } /* namespace ns3 */
@@ -87,6 +87,39 @@ TcpCongestionOps::CongControl(Ptr<TcpSocketState> tcb,
     NS_LOG_FUNCTION(this << tcb);
 }
 
+bool
+TcpCongestionOps::HasPacketEvents() const
+{
+    return false;
+}
+
+void
+TcpCongestionOps::OnPacketSent(Ptr<TcpSocketState> tcb,
+                               SequenceNumber32 seq,
+                               uint32_t size,
+                               const Time& sentTime)
+{
+    NS_LOG_FUNCTION(this << tcb << seq << size << sentTime);
+}
+
+void
+TcpCongestionOps::OnPacketAcked(Ptr<TcpSocketState> tcb,
+                                SequenceNumber32 seq,
+                                uint32_t size,
+                                const Time& sentTime)
+{
+    NS_LOG_FUNCTION(this << tcb << seq << size << sentTime);
+}
+
+void
+TcpCongestionOps::OnPacketLost(Ptr<TcpSocketState> tcb,
+                               SequenceNumber32 seq,
+                               uint32_t size,
+                               const Time& sentTime)
+{
+    NS_LOG_FUNCTION(this << tcb << seq << size << sentTime);
+}
+
 // RENO
 
 NS_OBJECT_ENSURE_REGISTERED(TcpNewReno);
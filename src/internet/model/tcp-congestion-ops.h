@@ -184,6 +184,64 @@ class TcpCongestionOps : public Object
                              const TcpRateOps::TcpRateConnection& rc,
                              const TcpRateOps::TcpRateSample& rs);
 
+    /**
+     * \brief Returns true when Congestion Control Algorithm wants per-segment events
+     *
+     * \return true if CC implements OnPacketSent, OnPacketAcked and OnPacketLost
+     *
+     * As for HasCongControl, TcpSocketBase checks this before building the
+     * per-segment notifications, so that congestion controls which do not
+     * need them (the default) do not pay for them. Rate-based algorithms
+     * which account each segment (e.g., PCC) should return true.
+     */
+    virtual bool HasPacketEvents() const;
+
+    /**
+     * \brief Called when a segment is (re)transmitted
+     *
+     * Only invoked if HasPacketEvents returns true.
+     *
+     * \param tcb internal congestion state
+     * \param seq sequence number of the first byte of the segment
+     * \param size size of the segment (in the sequence number space)
+     * \param sentTime the transmission time
+     */
+    virtual void OnPacketSent(Ptr<TcpSocketState> tcb,
+                              SequenceNumber32 seq,
+                              uint32_t size,
+                              const Time& sentTime);
+
+    /**
+     * \brief Called when a segment is delivered, either cumulatively ACKed or SACKed
+     *
+     * Only invoked if HasPacketEvents returns true. Each segment is reported
+     * once, even if it is first SACKed and then cumulatively ACKed.
+     *
+     * \param tcb internal congestion state
+     * \param seq sequence number of the first byte of the segment
+     * \param size size of the segment (in the sequence number space)
+     * \param sentTime the time of the last transmission of the segment
+     */
+    virtual void OnPacketAcked(Ptr<TcpSocketState> tcb,
+                               SequenceNumber32 seq,
+                               uint32_t size,
+                               const Time& sentTime);
+
+    /**
+     * \brief Called when a segment is deemed lost, right before its retransmission
+     *
+     * Only invoked if HasPacketEvents returns true.
+     *
+     * \param tcb internal congestion state
+     * \param seq sequence number of the first byte of the segment
+     * \param size size of the retransmitted segment (in the sequence number space)
+     * \param sentTime the time of the previous transmission of the segment
+     */
+    virtual void OnPacketLost(Ptr<TcpSocketState> tcb,
+                              SequenceNumber32 seq,
+                              uint32_t size,
+                              const Time& sentTime);
+
     // Present in Linux but not in ns-3 yet:
     /* call when ack arrives (optional) */
     //     void (*in_ack_event)(struct sock *sk, u32 flags);
@@ -25,6 +25,7 @@
 #include "ns3/buffer.h"
 #include "ns3/log.h"
 
+#include <array>
 #include <iostream>
 #include <stdint.h>
 
@@ -35,6 +36,44 @@ NS_LOG_COMPONENT_DEFINE("TcpHeader");
 
 NS_OBJECT_ENSURE_REGISTERED(TcpHeader);
 
+namespace
+{
+
+/** Number of options of each kind kept for reuse by TcpHeader::Deserialize. */
+constexpr std::size_t OPTION_CACHE_SIZE = 4;
+
+/**
+ * Get an option to deserialize into.
+ *
+ * The options created by TcpHeader::Deserialize are kept in a per-thread
+ * cache, and an option is reused once the cache holds its only reference,
+ * i.e., once the headers which held it are gone. Deserializing the
+ * headers of the segments thus does not create options in the steady state.
+ *
+ * \param [in] kind The option kind, as passed to TcpOption::CreateOption.
+ * \returns An option of the kind, not referenced by any header.
+ */
+Ptr<TcpOption>
+GetOptionToDeserialize(uint8_t kind)
+{
+    static thread_local std::array<Ptr<TcpOption>, OPTION_CACHE_SIZE> cache[256];
+    for (auto& option : cache[kind])
+    {
+        if (!option)
+        {
+            option = TcpOption::CreateOption(kind);
+            return option;
+        }
+        if (option->GetReferenceCount() == 1)
+        {
+            return option;
+        }
+    }
+    return TcpOption::CreateOption(kind);
+}
+
+} // unnamed namespace
+
 TcpHeader::TcpHeader()
     : m_sourcePort(0),
       m_destinationPort(0),
@@ -378,11 +417,11 @@ TcpHeader::Deserialize(Buffer::Iterator start)
         uint32_t optionSize;
         if (TcpOption::IsKindKnown(kind))
         {
-            op = TcpOption::CreateOption(kind);
+            op = GetOptionToDeserialize(kind);
         }
         else
         {
-            op = TcpOption::CreateOption(TcpOption::UNKNOWN);
+            op = GetOptionToDeserialize(TcpOption::UNKNOWN);
             NS_LOG_WARN("Option kind " << static_cast<int>(kind) << " unknown, skipping.");
         }
         optionSize = op->Deserialize(i);
@@ -110,6 +110,11 @@ TcpOptionSack::Deserialize(Buffer::Iterator start)
     NS_LOG_LOGIC("Size: " << static_cast<uint32_t>(size));
     m_sackList.clear();
     uint8_t sackCount = (size - 2) / 8;
+    if (sackCount > MAX_SACK_BLOCKS)
+    {
+        NS_LOG_WARN("Malformed SACK option, too many blocks");
+        return 0;
+    }
     while (sackCount)
     {
         SequenceNumber32 leftEdge = SequenceNumber32(i.ReadNtohU32());
@@ -149,7 +154,7 @@ TcpOptionSack::ClearSackList()
     m_sackList.clear();
 }
 
-TcpOptionSack::SackList
+const TcpOptionSack::SackList&
 TcpOptionSack::GetSackList() const
 {
     NS_LOG_FUNCTION(this);
@@ -25,9 +25,13 @@
 #ifndef TCP_OPTION_SACK_H
 #define TCP_OPTION_SACK_H
 
+#include "ns3/assert.h"
 #include "ns3/sequence-number.h"
 #include "ns3/tcp-option.h"
 
+#include <algorithm>
+#include <array>
+
 namespace ns3
 {
 
@@ -45,6 +49,10 @@ namespace ns3
  * left and the right edge of the block. It means that with the 40-byte TCP
  * option limitation in addition to the presence of TCP Timestamp Option, the
  * maximum number of SACK blocks that can be appended to each segment is 3.
+ *
+ * The blocks are stored in a SackList, a fixed-capacity array held inline,
+ * so that building, copying and iterating the blocks of an ACK does not
+ * allocate memory.
  */
 class TcpOptionSack : public TcpOption
 {
@@ -57,7 +65,112 @@ class TcpOptionSack : public TcpOption
     TypeId GetInstanceTypeId() const override;
 
     typedef std::pair<SequenceNumber32, SequenceNumber32> SackBlock; //!< SACK block definition
-    typedef std::list<SackBlock> SackList;                           //!< SACK list definition
+
+    /// Maximum number of SACK blocks that fit in the 40 bytes of TCP option space
+    static constexpr uint32_t MAX_SACK_BLOCKS = 4;
+
+    /**
+     * \brief SACK list definition
+     *
+     * A list of at most MAX_SACK_BLOCKS blocks, stored inline. Iterators are
+     * pointers to the contiguous blocks, and are invalidated by any insertion
+     * or removal.
+     */
+    class SackList
+    {
+      public:
+        typedef SackBlock* iterator;             //!< Iterator
+        typedef const SackBlock* const_iterator; //!< Const iterator
+
+        SackList();
+
+        /**
+         * \return an iterator to the first block
+         */
+        iterator begin();
+        /**
+         * \return an iterator past the last block
+         */
+        iterator end();
+        /**
+         * \return a const iterator to the first block
+         */
+        const_iterator begin() const;
+        /**
+         * \return a const iterator past the last block
+         */
+        const_iterator end() const;
+
+        /**
+         * \return a pointer to the contiguous blocks
+         */
+        const SackBlock* data() const;
+        /**
+         * \return the number of blocks
+         */
+        std::size_t size() const;
+        /**
+         * \return true if there are no blocks
+         */
+        bool empty() const;
+        /**
+         * \return true if no more blocks can be added
+         */
+        bool full() const;
+
+        /**
+         * \param i the index of the block
+         * \return the block
+         */
+        const SackBlock& operator[](std::size_t i) const;
+        /**
+         * \return the first block
+         */
+        const SackBlock& front() const;
+        /**
+         * \return the last block
+         */
+        const SackBlock& back() const;
+
+        /**
+         * \brief Add a block at the end; the list must not be full
+         * \param block the block
+         */
+        void push_back(const SackBlock& block);
+        /**
+         * \brief Add a block at the beginning; the list must not be full
+         * \param block the block
+         */
+        void push_front(const SackBlock& block);
+        /**
+         * \brief Remove the first block
+         */
+        void pop_front();
+        /**
+         * \brief Remove the last block
+         */
+        void pop_back();
+        /**
+         * \brief Remove a block, keeping the order of the others
+         * \param it the block to remove
+         * \return an iterator to the block which followed the removed one
+         */
+        iterator erase(iterator it);
+        /**
+         * \brief Remove all the blocks
+         */
+        void clear();
+
+        /**
+         * \param other the list to compare with
+         * \return true if both lists have the same blocks in the same order
+         */
+        bool operator==(const SackList& other) const;
+
+      private:
+        std::array<SackBlock, MAX_SACK_BLOCKS> m_blocks; //!< Storage of the blocks
+        uint8_t m_size;                                  //!< Number of blocks
+    };
 
     TcpOptionSack();
     ~TcpOptionSack() override;
@@ -71,6 +184,9 @@ class TcpOptionSack : public TcpOption
 
     /**
      * \brief Add a SACK block
+     *
+     * At most MAX_SACK_BLOCKS blocks can be added.
+     *
      * \param s the SACK block to be added
      */
     void AddSackBlock(SackBlock s);
@@ -90,7 +206,7 @@ class TcpOptionSack : public TcpOption
      * \brief Get the SACK list
      * \return the SACK list
      */
-    SackList GetSackList() const;
+    const SackList& GetSackList() const;
 
     friend std::ostream& operator<<(std::ostream& os, const TcpOptionSack& sackOption);
 
@@ -114,6 +230,130 @@ std::ostream& operator<<(std::ostream& os, const TcpOptionSack& sackOption);
  */
 std::ostream& operator<<(std::ostream& os, const TcpOptionSack::SackBlock& sackBlock);
 
+inline TcpOptionSack::SackList::SackList()
+    : m_size(0)
+{
+}
+
+inline TcpOptionSack::SackList::iterator
+TcpOptionSack::SackList::begin()
+{
+    return m_blocks.data();
+}
+
+inline TcpOptionSack::SackList::iterator
+TcpOptionSack::SackList::end()
+{
+    return m_blocks.data() + m_size;
+}
+
+inline TcpOptionSack::SackList::const_iterator
+TcpOptionSack::SackList::begin() const
+{
+    return m_blocks.data();
+}
+
+inline TcpOptionSack::SackList::const_iterator
+TcpOptionSack::SackList::end() const
+{
+    return m_blocks.data() + m_size;
+}
+
+inline const TcpOptionSack::SackBlock*
+TcpOptionSack::SackList::data() const
+{
+    return m_blocks.data();
+}
+
+inline std::size_t
+TcpOptionSack::SackList::size() const
+{
+    return m_size;
+}
+
+inline bool
+TcpOptionSack::SackList::empty() const
+{
+    return m_size == 0;
+}
+
+inline bool
+TcpOptionSack::SackList::full() const
+{
+    return m_size == MAX_SACK_BLOCKS;
+}
+
+inline const TcpOptionSack::SackBlock&
+TcpOptionSack::SackList::operator[](std::size_t i) const
+{
+    NS_ASSERT(i < m_size);
+    return m_blocks[i];
+}
+
+inline const TcpOptionSack::SackBlock&
+TcpOptionSack::SackList::front() const
+{
+    NS_ASSERT(m_size > 0);
+    return m_blocks[0];
+}
+
+inline const TcpOptionSack::SackBlock&
+TcpOptionSack::SackList::back() const
+{
+    NS_ASSERT(m_size > 0);
+    return m_blocks[m_size - 1];
+}
+
+inline void
+TcpOptionSack::SackList::push_back(const SackBlock& block)
+{
+    NS_ASSERT_MSG(!full(), "Too many SACK blocks");
+    m_blocks[m_size++] = block;
+}
+
+inline void
+TcpOptionSack::SackList::push_front(const SackBlock& block)
+{
+    NS_ASSERT_MSG(!full(), "Too many SACK blocks");
+    std::move_backward(begin(), end(), end() + 1);
+    m_blocks[0] = block;
+    m_size++;
+}
+
+inline void
+TcpOptionSack::SackList::pop_front()
+{
+    erase(begin());
+}
+
+inline void
+TcpOptionSack::SackList::pop_back()
+{
+    NS_ASSERT(m_size > 0);
+    m_size--;
+}
+
+inline TcpOptionSack::SackList::iterator
+TcpOptionSack::SackList::erase(iterator it)
+{
+    NS_ASSERT(it >= begin() && it < end());
+    std::move(it + 1, end(), it);
+    m_size--;
+    return it;
+}
+
+inline void
+TcpOptionSack::SackList::clear()
+{
+    m_size = 0;
+}
+
+inline bool
+TcpOptionSack::SackList::operator==(const SackList& other) const
+{
+    return std::equal(begin(), end(), other.begin(), other.end());
+}
+
 } // namespace ns3
 
 #endif /* TCP_OPTION_SACK */
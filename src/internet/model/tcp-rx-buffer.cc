@@ -287,60 +287,46 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
     //     following SACK blocks in the SACK option may be listed in
     //     arbitrary order.
 
-    m_sackList.push_front(current);
-
-    // We have inserted the block at the beginning of the list. Now, we should
-    // check if any existing blocks overlap with that.
-    bool updated = false;
+    // Merge the block "current" with the existing blocks contiguous to it,
+    // which are removed from the list; the merged block is then inserted at
+    // the beginning of the list.
     TcpOptionSack::SackList::iterator it = m_sackList.begin();
-    TcpOptionSack::SackBlock begin = *it;
-    TcpOptionSack::SackBlock merged;
-    ++it;
 
     // Iterates until we examined all blocks in the list (maximum 4)
     while (it != m_sackList.end())
     {
-        current = *it;
-
         // This is a left merge:
-        // [current_first; current_second] [beg_first; beg_second]
-        if (begin.first == current.second)
+        // [it_first; it_second] [current_first; current_second]
+        if (current.first == it->second)
         {
-            NS_ASSERT(current.first < begin.second);
-            merged = TcpOptionSack::SackBlock(current.first, begin.second);
-            updated = true;
+            NS_ASSERT(it->first < current.second);
+            current.first = it->first;
         }
         // while this is a right merge
-        // [begin_first; begin_second] [current_first; current_second]
-        else if (begin.second == current.first)
+        // [current_first; current_second] [it_first; it_second]
+        else if (current.second == it->first)
         {
-            NS_ASSERT(begin.first < current.second);
-            merged = TcpOptionSack::SackBlock(begin.first, current.second);
-            updated = true;
+            NS_ASSERT(current.first < it->second);
+            current.second = it->second;
         }
-
-        // If we have merged the blocks (and the result is in merged) we should
-        // delete the current block (it), the first block, and insert the merged
-        // one at the beginning.
-        if (updated)
+        else
         {
-            m_sackList.erase(it);
-            m_sackList.pop_front();
-            m_sackList.push_front(merged);
-            it = m_sackList.begin();
-            begin = *it;
-            updated = false;
+            ++it;
+            continue;
         }
 
-        ++it;
+        // The merged block may now be contiguous to a block already examined
+        m_sackList.erase(it);
+        it = m_sackList.begin();
     }
 
     // Since the maximum blocks that fits into a TCP header are 4, there's no
     // point on maintaining the others.
-    if (m_sackList.size() > 4)
+    if (m_sackList.full())
     {
         m_sackList.pop_back();
     }
+    m_sackList.push_front(current);
 
     // Please note that, if a block b is discarded and then a block contiguous
     // to b is received, only that new block (without the b part) is reported.
@@ -356,10 +342,9 @@ TcpRxBuffer::ClearSackList(const SequenceNumber32& seq)
     TcpOptionSack::SackList::iterator it;
     for (it = m_sackList.begin(); it != m_sackList.end();)
     {
-        TcpOptionSack::SackBlock block = *it;
-        NS_ASSERT(block.first < block.second);
+        NS_ASSERT(it->first < it->second);
 
-        if (block.second <= seq)
+        if (it->second <= seq)
         {
             it = m_sackList.erase(it);
         }
@@ -370,7 +355,7 @@ TcpRxBuffer::ClearSackList(const SequenceNumber32& seq)
     }
 }
 
-TcpOptionSack::SackList
+const TcpOptionSack::SackList&
 TcpRxBuffer::GetSackList() const
 {
     return m_sackList;
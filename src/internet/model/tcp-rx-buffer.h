@@ -167,7 +167,7 @@ class TcpRxBuffer : public Object
      *
      * \return a list of isolated blocks
      */
-    TcpOptionSack::SackList GetSackList() const;
+    const TcpOptionSack::SackList& GetSackList() const;
 
     /**
      * \brief Get the size of Sack list
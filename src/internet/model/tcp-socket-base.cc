@@ -1597,7 +1597,7 @@ TcpSocketBase::ReadOptions(const TcpHeader& tcpHeader, uint32_t* bytesSacked)
 {
     NS_LOG_FUNCTION(this << tcpHeader);
     TcpHeader::TcpOptionList::const_iterator it;
-    const TcpHeader::TcpOptionList options = tcpHeader.GetOptionList();
+    const TcpHeader::TcpOptionList& options = tcpHeader.GetOptionList();
 
     for (it = options.begin(); it != options.end(); ++it)
     {
@@ -1855,7 +1855,15 @@ TcpSocketBase::ReceivedAck(Ptr<Packet> packet, const TcpHeader& tcpHeader)
         }
     }
 
-    m_txBuffer->DiscardUpTo(ackNumber, MakeCallback(&TcpRateOps::SkbDelivered, m_rateOps));
+    if (m_congestionControl->HasPacketEvents())
+    {
+        m_txBuffer->DiscardUpTo(ackNumber,
+                                MakeCallback(&TcpSocketBase::NotifySegmentDiscarded, this));
+    }
+    else
+    {
+        m_txBuffer->DiscardUpTo(ackNumber, MakeCallback(&TcpRateOps::SkbDelivered, m_rateOps));
+    }
 
     uint32_t currentDelivered =
         static_cast<uint32_t>(m_rateOps->GetConnectionRate().m_delivered - previousDelivered);
@@ -3121,6 +3129,10 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     NS_LOG_FUNCTION(this << seq << maxSize << withAck);
 
     bool isStartOfTransmission = BytesInFlight() == 0U;
+    bool hasPacketEvents = m_congestionControl->HasPacketEvents();
+    // Only a retransmission has a previous transmission time
+    Time lastSent = hasPacketEvents && seq < m_tcb->m_highTxMark ? m_txBuffer->GetLastSent(seq)
+                                                                  : Time::Max();
     TcpTxItem* outItem = m_txBuffer->CopyFromSequence(maxSize, seq);
 
     m_rateOps->SkbSent(outItem, isStartOfTransmission);
@@ -3242,6 +3254,19 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
 
     UpdateRttHistory(seq, sz, isRetransmission);
 
+    if (hasPacketEvents)
+    {
+        // A retransmission means that the previous transmission has been lost
+        if (isRetransmission && lastSent != Time::Max())
+        {
+            m_congestionControl->OnPacketLost(m_tcb, seq, outItem->GetSeqSize(), lastSent);
+        }
+        m_congestionControl->OnPacketSent(m_tcb,
+                                          seq,
+                                          outItem->GetSeqSize(),
+                                          outItem->GetLastSent());
+    }
+
     // Update bytes sent during recovery phase
     if (m_tcb->m_congState == TcpSocketState::CA_RECOVERY ||
         m_tcb->m_congState == TcpSocketState::CA_CWR)
@@ -4275,6 +4300,11 @@ TcpSocketBase::ProcessOptionSack(const Ptr<const TcpOption> option)
     NS_LOG_FUNCTION(this << option);
 
     Ptr<const TcpOptionSack> s = DynamicCast<const TcpOptionSack>(option);
+    if (m_congestionControl->HasPacketEvents())
+    {
+        return m_txBuffer->Update(s->GetSackList(),
+                                  MakeCallback(&TcpSocketBase::NotifySegmentSacked, this));
+    }
     return m_txBuffer->Update(s->GetSackList(), MakeCallback(&TcpRateOps::SkbDelivered, m_rateOps));
 }
 
@@ -4309,24 +4339,33 @@ TcpSocketBase::AddOptionSack(TcpHeader& header)
     uint8_t optionLenAvail = header.GetMaxOptionLength() - header.GetOptionLength();
     uint8_t allowedSackBlocks = (optionLenAvail - 2) / 8;
 
-    TcpOptionSack::SackList sackList = m_tcb->m_rxBuffer->GetSackList();
+    const TcpOptionSack::SackList& sackList = m_tcb->m_rxBuffer->GetSackList();
     if (allowedSackBlocks == 0 || sackList.empty())
     {
         NS_LOG_LOGIC("No space available or sack list empty, not adding sack blocks");
         return;
     }
 
+    // Reuse the option of the previous ACK, unless a header still holds it
+    if (!m_sackOption || m_sackOption->GetReferenceCount() > 1)
+    {
+        m_sackOption = CreateObject<TcpOptionSack>();
+    }
+    else
+    {
+        m_sackOption->ClearSackList();
+    }
+
     // Append the allowed number of SACK blocks
-    Ptr<TcpOptionSack> option = CreateObject<TcpOptionSack>();
-    TcpOptionSack::SackList::iterator i;
+    TcpOptionSack::SackList::const_iterator i;
     for (i = sackList.begin(); allowedSackBlocks > 0 && i != sackList.end(); ++i)
     {
-        option->AddSackBlock(*i);
+        m_sackOption->AddSackBlock(*i);
         allowedSackBlocks--;
     }
 
-    header.AppendOption(option);
-    NS_LOG_INFO(m_node->GetId() << " Add option SACK " << *option);
+    header.AppendOption(m_sackOption);
+    NS_LOG_INFO(m_node->GetId() << " Add option SACK " << *m_sackOption);
 }
 
 void
@@ -4565,6 +4604,39 @@ TcpSocketBase::NotifyPacingPerformed()
     SendPendingData(m_connected);
 }
 
+void
+TcpSocketBase::NotifySegmentDiscarded(TcpTxItem* item)
+{
+    NS_LOG_FUNCTION(this << item);
+    m_rateOps->SkbDelivered(item);
+    // SACKed segments have already been reported when the SACK was received,
+    // even if an RTO has reset their SACK flag since.
+    if (!item->IsAckReported())
+    {
+        item->SetAckReported();
+        m_congestionControl->OnPacketAcked(m_tcb,
+                                           item->GetStartSeq(),
+                                           item->GetSeqSize(),
+                                           item->GetLastSent());
+    }
+}
+
+void
+TcpSocketBase::NotifySegmentSacked(TcpTxItem* item)
+{
+    NS_LOG_FUNCTION(this << item);
+    m_rateOps->SkbDelivered(item);
+    // A segment SACKed again after an RTO has already been reported
+    if (!item->IsAckReported())
+    {
+        item->SetAckReported();
+        m_congestionControl->OnPacketAcked(m_tcb,
+                                           item->GetStartSeq(),
+                                           item->GetSeqSize(),
+                                           item->GetLastSent());
+    }
+}
+
 bool
 TcpSocketBase::IsPacingEnabled() const
 {
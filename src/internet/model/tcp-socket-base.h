@@ -47,7 +47,9 @@ class TcpRecoveryOps;
 class RttEstimator;
 class TcpRxBuffer;
 class TcpTxBuffer;
+class TcpTxItem;
 class TcpOption;
+class TcpOptionSack;
 class Ipv4Interface;
 class Ipv6Interface;
 class TcpRateOps;
@@ -1241,6 +1243,22 @@ class TcpSocketBase : public TcpSocket
      */
     void NotifyPacingPerformed();
 
+    /**
+     * \brief Notify the rate and congestion control of a cumulatively ACKed segment
+     *
+     * Used only if the congestion control wants per-segment events.
+     * \param item the segment removed from the transmission buffer
+     */
+    void NotifySegmentDiscarded(TcpTxItem* item);
+
+    /**
+     * \brief Notify the rate and congestion control of a SACKed segment
+     *
+     * Used only if the congestion control wants per-segment events.
+     * \param item the segment marked as SACKed in the transmission buffer
+     */
+    void NotifySegmentSacked(TcpTxItem* item);
+
     /**
      * \brief Return true if packets in the current window should be paced
      * \return true if pacing is currently enabled
@@ -1345,12 +1363,13 @@ class TcpSocketBase : public TcpSocket
     TracedValue<SequenceNumber32> m_highRxAckMark{0}; //!< Highest ack received
 
     // Options
-    bool m_sackEnabled{true};       //!< RFC SACK option enabled
-    bool m_winScalingEnabled{true}; //!< Window Scale option enabled (RFC 7323)
-    uint8_t m_rcvWindShift{0};      //!< Window shift to apply to outgoing segments
-    uint8_t m_sndWindShift{0};      //!< Window shift to apply to incoming segments
-    bool m_timestampEnabled{true};  //!< Timestamp option enabled
-    uint32_t m_timestampToEcho{0};  //!< Timestamp to echo
+    bool m_sackEnabled{true};        //!< RFC SACK option enabled
+    bool m_winScalingEnabled{true};  //!< Window Scale option enabled (RFC 7323)
+    uint8_t m_rcvWindShift{0};       //!< Window shift to apply to outgoing segments
+    uint8_t m_sndWindShift{0};       //!< Window shift to apply to incoming segments
+    bool m_timestampEnabled{true};   //!< Timestamp option enabled
+    uint32_t m_timestampToEcho{0};   //!< Timestamp to echo
+    Ptr<TcpOptionSack> m_sackOption; //!< SACK option of the ACKs, reused once they are sent
 
     EventId m_sendPendingDataEvent{}; //!< micro-delay event to send pending data
 
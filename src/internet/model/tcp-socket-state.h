@@ -166,13 +166,24 @@ class TcpSocketState : public Object
      */
     static const char* const EcnStateName[TcpSocketState::ECN_CWR_SENT + 1];
 
+    /**
+     * The trace sources of the congestion state which change on each
+     * segment or ACK: plain values when ns-3 is built with
+     * NS3_ELIDE_HOT_TRACES (see TracedValuePolicy::Hot), in which case the
+     * corresponding trace sources of TcpSocketBase never fire.
+     *
+     * \tparam T \explicit The type of the value.
+     */
+    template <typename T>
+    using HotTracedValue = TracedValue<T, TracedValuePolicy::Hot>;
+
     // Congestion control
-    TracedValue<uint32_t> m_cWnd{0}; //!< Congestion window
-    TracedValue<uint32_t> m_cWndInfl{
+    HotTracedValue<uint32_t> m_cWnd{0}; //!< Congestion window
+    HotTracedValue<uint32_t> m_cWndInfl{
         0}; //!< Inflated congestion window trace (used only for backward compatibility purpose)
-    TracedValue<uint32_t> m_ssThresh{0}; //!< Slow start threshold
-    uint32_t m_initialCWnd{0};           //!< Initial cWnd value
-    uint32_t m_initialSsThresh{0};       //!< Initial Slow Start Threshold value
+    HotTracedValue<uint32_t> m_ssThresh{0}; //!< Slow start threshold
+    uint32_t m_initialCWnd{0};              //!< Initial cWnd value
+    uint32_t m_initialSsThresh{0};          //!< Initial Slow Start Threshold value
 
     // Recovery
     // This variable is used for implementing following flag of Linux: FLAG_RETRANS_DATA_ACKED
@@ -189,25 +200,26 @@ class TcpSocketState : public Object
     TracedValue<EcnState_t> m_ecnState{
         ECN_DISABLED}; //!< Current ECN State, represented as combination of EcnState values
 
-    TracedValue<SequenceNumber32> m_highTxMark{0}; //!< Highest seqno ever sent, regardless of ReTx
-    TracedValue<SequenceNumber32> m_nextTxSequence{
+    HotTracedValue<SequenceNumber32> m_highTxMark{
+        0}; //!< Highest seqno ever sent, regardless of ReTx
+    HotTracedValue<SequenceNumber32> m_nextTxSequence{
         0}; //!< Next seqnum to be sent (SND.NXT), ReTx pushes it back
 
     uint32_t m_rcvTimestampValue{0};     //!< Receiver Timestamp value
     uint32_t m_rcvTimestampEchoReply{0}; //!< Sender Timestamp echoed by the receiver
 
     // Pacing related variables
-    bool m_pacing{false};                  //!< Pacing status
-    DataRate m_maxPacingRate{0};           //!< Max Pacing rate
-    TracedValue<DataRate> m_pacingRate{0}; //!< Current Pacing rate
-    uint16_t m_pacingSsRatio{0};           //!< SS pacing ratio
-    uint16_t m_pacingCaRatio{0};           //!< CA pacing ratio
-    bool m_paceInitialWindow{false};       //!< Enable/Disable pacing for the initial window
+    bool m_pacing{false};                     //!< Pacing status
+    DataRate m_maxPacingRate{0};              //!< Max Pacing rate
+    HotTracedValue<DataRate> m_pacingRate{0}; //!< Current Pacing rate
+    uint16_t m_pacingSsRatio{0};              //!< SS pacing ratio
+    uint16_t m_pacingCaRatio{0};              //!< CA pacing ratio
+    bool m_paceInitialWindow{false};          //!< Enable/Disable pacing for the initial window
 
     Time m_minRtt{Time::Max()}; //!< Minimum RTT observed throughout the connection
 
-    TracedValue<uint32_t> m_bytesInFlight{0};  //!< Bytes in flight
-    TracedValue<Time> m_lastRtt{Seconds(0.0)}; //!< Last RTT sample collected
+    HotTracedValue<uint32_t> m_bytesInFlight{0};  //!< Bytes in flight
+    HotTracedValue<Time> m_lastRtt{Seconds(0.0)}; //!< Last RTT sample collected
 
     Ptr<TcpRxBuffer> m_rxBuffer; //!< Rx buffer (reordering buffer)
 
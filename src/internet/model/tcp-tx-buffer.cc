@@ -61,9 +61,11 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostMarked(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
+    m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
 }
 
 TcpTxBuffer::~TcpTxBuffer()
@@ -137,6 +139,7 @@ void
 TcpTxBuffer::SetDupAckThresh(uint32_t dupAckThresh)
 {
     m_dupAckThresh = dupAckThresh;
+    m_lostMarked = m_firstByteSeq;
 }
 
 void
@@ -177,6 +180,7 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     // if you change the head with data already sent, something bad will happen
     NS_ASSERT(m_sentList.size() == 0);
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostMarked = seq;
 }
 
 bool
@@ -325,9 +329,10 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
             next++;
             if (next != m_sentList.end())
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
+                // Next is not sacked and have the same value for m_lost and
+                // m_ackReported ... there is the possibility to merge
+                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost) &&
+                    ((*it)->m_ackReported == (*next)->m_ackReported))
                 {
                     s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
                 }
@@ -392,6 +397,7 @@ TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
     t1->m_lastSent = t2->m_lastSent;
     t1->m_retrans = t2->m_retrans;
     t1->m_lost = t2->m_lost;
+    t1->m_ackReported = t2->m_ackReported;
 
     t2->m_startSeq += size;
 
@@ -771,6 +777,10 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
     {
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
+    if (m_lostMarked < m_firstByteSeq)
+    {
+        m_lostMarked = m_firstByteSeq;
+    }
 
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
@@ -790,7 +800,7 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        PacketList::iterator item_it = m_sentList.begin();
+        PacketList::const_iterator item_it = m_sentList.begin();
         SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
 
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
@@ -799,6 +809,16 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
             return bytesSacked;
         }
 
+        // A block above the highest SACK (the common case of newly SACKed
+        // data) is searched from it, rather than from SND.UNA
+        if (m_highestSack.first != m_sentList.end() && m_highestSack.second > m_firstByteSeq &&
+            (*option_it).first >= m_highestSack.second)
+        {
+            NS_ASSERT((*m_highestSack.first)->m_startSeq == m_highestSack.second);
+            item_it = m_highestSack.first;
+            beginOfCurrentPacket = m_highestSack.second;
+        }
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -831,7 +851,7 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                     bytesSacked += (*item_it)->m_packet->GetSize();
 
                     if (m_highestSack.first == m_sentList.end() ||
-                        m_highestSack.second <= beginOfCurrentPacket + pktSize)
+                        m_highestSack.second < beginOfCurrentPacket)
                     {
                         m_highestSack = std::make_pair(item_it, beginOfCurrentPacket);
                     }
@@ -878,8 +898,6 @@ void
 TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
-    uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
     if (m_highestSack.first == m_sentList.end())
     {
         NS_LOG_INFO("Status before the update: " << *this
@@ -891,38 +909,73 @@ TcpTxBuffer::UpdateLostCount()
                                                  << *(*m_highestSack.first));
     }
 
-    for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
+    // Find the DupThresh-th sacked segment, counting from the highest one:
+    // every segment below it which is not sacked is lost.
+    uint32_t sacked = 0;
+    auto it = m_highestSack.first;
+    for (; it != m_sentList.begin(); --it)
     {
-        TcpTxItem* item = *it;
-        if (item->m_sacked)
+        if ((*it)->m_sacked && ++sacked >= m_dupAckThresh)
         {
-            sacked++;
+            break;
         }
+    }
 
-        if (sacked >= m_dupAckThresh)
-        {
-            if (!item->m_sacked && !item->m_lost)
-            {
-                item->m_lost = true;
-                m_lostOut += item->m_packet->GetSize();
-            }
-        }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
+    if (sacked < m_dupAckThresh)
+    {
+        NS_LOG_INFO("Status after the update: " << *this);
+        ConsistencyCheck();
+        return;
     }
 
-    if (sacked >= m_dupAckThresh)
+    // The segments below m_lostMarked have already been marked, and that
+    // point only moves forward as SACK blocks arrive: each segment is
+    // visited once per recovery, instead of once per ACK
+    SequenceNumber32 threshold = (*it)->m_startSeq;
+    for (--it; it != m_sentList.begin() && (*it)->m_startSeq >= m_lostMarked; --it)
     {
-        TcpTxItem* item = *m_sentList.begin();
-        if (!item->m_lost)
+        TcpTxItem* item = *it;
+        if (!item->m_sacked && !item->m_lost)
         {
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
         }
     }
+
+    TcpTxItem* item = *m_sentList.begin();
+    if (!item->m_lost)
+    {
+        item->m_lost = true;
+        m_lostOut += item->m_packet->GetSize();
+    }
+
+    if (threshold > m_lostMarked)
+    {
+        m_lostMarked = threshold;
+    }
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
 }
 
+Time
+TcpTxBuffer::GetLastSent(const SequenceNumber32& seq) const
+{
+    NS_LOG_FUNCTION(this << seq);
+
+    for (const auto& item : m_sentList)
+    {
+        if (seq < item->m_startSeq)
+        {
+            break;
+        }
+        if (seq < item->m_startSeq + item->GetSeqSize())
+        {
+            return item->m_lastSent;
+        }
+    }
+    return Time::Max();
+}
+
 bool
 TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
 {
@@ -1092,25 +1145,24 @@ TcpTxBuffer::BytesInFlight() const
 uint32_t
 TcpTxBuffer::BytesInFlightRFC() const
 {
-    PacketList::const_iterator it;
-    TcpTxItem* item;
     uint32_t size = 0; // "pipe" in RFC
-    SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
     uint32_t sackedOut = 0;
     uint32_t lostOut = 0;
     uint32_t retrans = 0;
     uint32_t totalSize = 0;
+    uint32_t sackedAbove = 0; // Number of sacked segments above the current one
 
     // After initializing pipe to zero, the following steps are taken for each
     // octet 'S1' in the sequence space between HighACK and HighData that has not
-    // been SACKed:
-    for (it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // been SACKed. The list is walked backward, so that the SACKed segments
+    // above each segment are counted once for all, instead of once per segment.
+    for (auto it = m_sentList.rbegin(); it != m_sentList.rend(); ++it)
     {
-        item = *it;
+        TcpTxItem* item = *it;
         totalSize += item->m_packet->GetSize();
         if (!item->m_sacked)
         {
-            bool isLost = IsLostRFC(beginOfCurrentPkt, it);
+            bool isLost = IsLostRFC(item, sackedAbove, sackedOut);
             // (a) If IsLost (S1) returns false: Pipe is incremented by 1 octet.
             if (!isLost)
             {
@@ -1131,6 +1183,7 @@ TcpTxBuffer::BytesInFlightRFC() const
         }
         else
         {
+            ++sackedAbove;
             sackedOut += item->m_packet->GetSize();
         }
 
@@ -1138,7 +1191,6 @@ TcpTxBuffer::BytesInFlightRFC() const
         {
             retrans += item->m_packet->GetSize();
         }
-        beginOfCurrentPkt += item->m_packet->GetSize();
     }
 
     NS_ASSERT_MSG(lostOut == m_lostOut,
@@ -1156,17 +1208,11 @@ TcpTxBuffer::BytesInFlightRFC() const
 }
 
 bool
-TcpTxBuffer::IsLostRFC(const SequenceNumber32& seq, const PacketList::const_iterator& segment) const
+TcpTxBuffer::IsLostRFC(const TcpTxItem* item, uint32_t sackedAbove, uint32_t bytesAbove) const
 {
-    NS_LOG_FUNCTION(this << seq);
-    uint32_t count = 0;
-    uint32_t bytes = 0;
-    PacketList::const_iterator it;
-    TcpTxItem* item;
-    Ptr<const Packet> current;
-    SequenceNumber32 beginOfCurrentPacket = seq;
+    NS_LOG_FUNCTION(this << *item << sackedAbove << bytesAbove);
 
-    if ((*segment)->m_sacked == true)
+    if (item->m_sacked)
     {
         return false;
     }
@@ -1176,42 +1222,21 @@ TcpTxBuffer::IsLostRFC(const SequenceNumber32& seq, const PacketList::const_iter
     // > sequences have arrived above 'seq' or more than (dupThresh - 1) * SMSS bytes
     // > with sequence numbers greater than 'SeqNum' have been SACKed.  Otherwise, the
     // > routine returns false.
-    for (it = segment; it != m_sentList.end(); ++it)
+    if (m_highestSack.first != m_sentList.end() && item->m_startSeq < m_highestSack.second)
     {
-        item = *it;
-        current = item->m_packet;
-
-        if (item->m_sacked)
-        {
-            NS_LOG_INFO("Segment " << *item << " found to be SACKed while checking for " << seq);
-            ++count;
-            bytes += current->GetSize();
-            if ((count >= m_dupAckThresh) || (bytes > (m_dupAckThresh - 1) * m_segmentSize))
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of 3 sacked blocks ahead");
-                return true;
-            }
-        }
-
-        if (beginOfCurrentPacket >= m_highestSack.second)
+        if ((sackedAbove >= m_dupAckThresh) || (bytesAbove > (m_dupAckThresh - 1) * m_segmentSize))
         {
-            if (item->m_lost && !item->m_retrans)
-            {
-                return true;
-            }
-
-            NS_LOG_INFO("seq=" << seq << " is not lost because there are no sacked segment ahead");
-            return false;
+            NS_LOG_INFO("seq=" << item->m_startSeq << " is lost because of 3 sacked blocks ahead");
+            return true;
         }
-
-        beginOfCurrentPacket += current->GetSize();
-    }
-    if (it == m_highestSack.first)
-    {
-        NS_LOG_INFO("seq=" << seq << " is not lost because there are no sacked segment ahead "
-                           << m_highestSack.second);
+        NS_LOG_INFO("seq=" << item->m_startSeq << " is not lost because there are not enough "
+                           << "sacked segments ahead");
+        return false;
     }
-    return false;
+
+    NS_LOG_INFO("seq=" << item->m_startSeq << " is not lost because there are no sacked segment "
+                       << "ahead");
+    return item->m_lost && !item->m_retrans;
 }
 
 void
@@ -1226,6 +1251,7 @@ TcpTxBuffer::ResetRenoSack()
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostMarked = m_firstByteSeq;
 }
 
 void
@@ -1255,6 +1281,7 @@ TcpTxBuffer::ResetSentList()
     m_retrans = 0;
     m_sackedOut = 0;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostMarked = m_firstByteSeq;
 }
 
 void
@@ -1287,6 +1314,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         m_sackedOut = 0;
         m_lostOut = m_sentSize;
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+        m_lostMarked = m_firstByteSeq;
     }
     else
     {
@@ -309,6 +309,15 @@ class TcpTxBuffer : public Object
      */
     bool IsLost(const SequenceNumber32& seq) const;
 
+    /**
+     * \brief Get the last transmission time of the segment containing a sequence
+     *
+     * \param seq sequence to check
+     * \return the time at which the segment containing seq has been sent for the
+     * last time, or Time::Max () if seq has not been sent
+     */
+    Time GetLastSent(const SequenceNumber32& seq) const;
+
     /**
      * \brief Get the next sequence number to transmit, according to RFC 6675
      *
@@ -427,8 +436,10 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
+     * and updates the lost count. It walks the list from the highest sacked
+     * segment down to the DupThresh-th sacked one, and then marks as lost
+     * only the segments that were not below the previous such point, so that
+     * the cost over a recovery is linear in the number of segments.
      *
      */
     void UpdateLostCount();
@@ -445,11 +456,12 @@ class TcpTxBuffer : public Object
 
     /**
      * \brief Decide if a segment is lost based on RFC 6675 algorithm.
-     * \param seq Sequence
-     * \param segment Iterator to the sequence
-     * \return true if seq is lost per RFC 6675, false otherwise
+     * \param item the segment
+     * \param sackedAbove number of sacked segments above the segment
+     * \param bytesAbove number of sacked bytes above the segment
+     * \return true if the segment is lost per RFC 6675, false otherwise
      */
-    bool IsLostRFC(const SequenceNumber32& seq, const PacketList::const_iterator& segment) const;
+    bool IsLostRFC(const TcpTxItem* item, uint32_t sackedAbove, uint32_t bytesAbove) const;
 
     /**
      * \brief Calculate the number of bytes in flight per RFC 6675
@@ -611,6 +623,7 @@ class TcpTxBuffer : public Object
     TracedValue<SequenceNumber32>
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
+    SequenceNumber32 m_lostMarked; //!< Segments below have been marked by UpdateLostCount
 
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
@@ -57,6 +57,12 @@ TcpTxItem::Print(std::ostream& os, Time::Unit unit /* = Time::S */) const
     os << "[" << m_lastSent.As(unit) << "]";
 }
 
+SequenceNumber32
+TcpTxItem::GetStartSeq() const
+{
+    return m_startSeq;
+}
+
 uint32_t
 TcpTxItem::GetSeqSize() const
 {
@@ -69,6 +75,18 @@ TcpTxItem::IsSacked() const
     return m_sacked;
 }
 
+bool
+TcpTxItem::IsAckReported() const
+{
+    return m_ackReported;
+}
+
+void
+TcpTxItem::SetAckReported()
+{
+    m_ackReported = true;
+}
+
 bool
 TcpTxItem::IsRetrans() const
 {
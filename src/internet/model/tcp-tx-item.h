@@ -41,6 +41,12 @@ class TcpTxItem
      */
     void Print(std::ostream& os, Time::Unit unit = Time::S) const;
 
+    /**
+     * \brief Get the sequence number of the item
+     * \return the sequence number of the first byte of the item (if transmitted)
+     */
+    SequenceNumber32 GetStartSeq() const;
+
     /**
      * \brief Get the size in the sequence number space
      *
@@ -54,6 +60,22 @@ class TcpTxItem
      */
     bool IsSacked() const;
 
+    /**
+     * \brief Has the delivery of the item been reported to the congestion control?
+     *
+     * The flag survives the reset of the SACK flags on an RTO, so that a
+     * segment SACKed before the RTO is not reported again when it is
+     * SACKed or cumulatively ACKed after it.
+     *
+     * \return true if TcpCongestionOps::OnPacketAcked has been called for the item
+     */
+    bool IsAckReported() const;
+
+    /**
+     * \brief Mark the delivery of the item as reported to the congestion control
+     */
+    void SetAckReported();
+
     /**
      * \brief Is the item retransmitted?
      * \return true if the item have been retransmitted
@@ -111,6 +133,7 @@ class TcpTxItem
     SequenceNumber32 m_startSeq{0}; //!< Sequence number of the item (if transmitted)
     Ptr<Packet> m_packet{nullptr};  //!< Application packet (can be null)
     bool m_lost{false};             //!< Indicates if the segment has been lost (RTO)
+    bool m_ackReported{false};      //!< Indicates if the delivery has been reported
     Time m_lastSent{
         Time::Max()};     //!< Timestamp of the time at which the segment has been sent last time
     bool m_sacked{false}; //!< Indicates if the segment has been SACKed
@@ -0,0 +1,261 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv4EndPointDemux lookup test.
+ *
+ * Checks that the hashed lookup returns the most specific endpoint, and that
+ * the index follows the endpoints peer changes and deallocations.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Lookup a single endpoint.
+     * \param demux the demux
+     * \param daddr destination address
+     * \param dport destination port
+     * \param saddr source address
+     * \param sport source port
+     * \return the endpoint found, or nullptr
+     */
+    Ipv4EndPoint* Lookup(Ipv4EndPointDemux& demux,
+                         Ipv4Address daddr,
+                         uint16_t dport,
+                         Ipv4Address saddr,
+                         uint16_t sport);
+
+    Ptr<Ipv4Interface> m_interface; //!< Incoming interface
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Ipv4EndPointDemux lookup")
+{
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemuxTestCase::Lookup(Ipv4EndPointDemux& demux,
+                                  Ipv4Address daddr,
+                                  uint16_t dport,
+                                  Ipv4Address saddr,
+                                  uint16_t sport)
+{
+    Ipv4EndPointDemux::EndPoints endPoints =
+        demux.Lookup(daddr, dport, saddr, sport, m_interface);
+    return endPoints.empty() ? nullptr : endPoints.front();
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    m_interface = CreateObject<Ipv4Interface>();
+    Ipv4EndPointDemux demux;
+
+    Ipv4Address local("10.0.0.1");
+    Ipv4Address other("10.0.0.254");
+
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listener allocation failed");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, 80), nullptr, "Duplicated listener allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), true, "Port 80 not found");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(81), false, "Port 81 found");
+
+    Ipv4EndPoint* bound = demux.Allocate(nullptr, local, 80);
+    NS_TEST_ASSERT_MSG_NE(bound, nullptr, "Bound listener allocation failed");
+
+    std::vector<Ipv4EndPoint*> connections;
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        Ipv4Address peer(Ipv4Address("10.1.0.0").Get() + i);
+        connections.push_back(demux.Allocate(nullptr, local, 80, peer, 1000 + i));
+        NS_TEST_ASSERT_MSG_NE(connections.back(), nullptr, "Connection allocation failed");
+    }
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, Ipv4Address("10.1.0.0"), 1000),
+                          nullptr,
+                          "Duplicated connection allocated");
+
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        Ipv4Address peer(Ipv4Address("10.1.0.0").Get() + i);
+        NS_TEST_EXPECT_MSG_EQ(Lookup(demux, local, 80, peer, 1000 + i),
+                              connections[i],
+                              "Connection not found");
+        NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(local, 80, peer, 1000 + i),
+                              connections[i],
+                              "Connection not found by SimpleLookup");
+    }
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, local, 80, Ipv4Address("10.1.0.0"), 999),
+                          bound,
+                          "Unknown peer not delivered to the bound listener");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, other, 80, Ipv4Address("10.1.0.0"), 1000),
+                          listener,
+                          "Unknown destination not delivered to the wildcard listener");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, local, 81, Ipv4Address("10.1.0.0"), 1000),
+                          nullptr,
+                          "Unknown port delivered");
+
+    demux.DeAllocate(connections[0]);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, local, 80, Ipv4Address("10.1.0.0"), 1000),
+                          bound,
+                          "Deallocated connection still found");
+
+    // The index must follow the peer changes done by the sockets
+    Ipv4EndPoint* client = demux.Allocate();
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Ephemeral allocation failed");
+    uint16_t port = client->GetLocalPort();
+    client->SetLocalAddress(other);
+    client->SetPeer(local, 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, other, port, local, 80), client, "Connected client lost");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, other, port, local, 81),
+                          nullptr,
+                          "Connected client accepts any peer");
+    client->SetPeer(Ipv4Address::GetAny(), 0);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, other, port, local, 81),
+                          client,
+                          "Disconnected client does not accept any peer");
+    demux.DeAllocate(client);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(port), false, "Deallocated port still in use");
+
+    m_interface = nullptr;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv6EndPointDemux lookup test.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Lookup a single endpoint.
+     * \param demux the demux
+     * \param daddr destination address
+     * \param dport destination port
+     * \param saddr source address
+     * \param sport source port
+     * \return the endpoint found, or nullptr
+     */
+    Ipv6EndPoint* Lookup(Ipv6EndPointDemux& demux,
+                         Ipv6Address daddr,
+                         uint16_t dport,
+                         Ipv6Address saddr,
+                         uint16_t sport);
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Ipv6EndPointDemux lookup")
+{
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemuxTestCase::Lookup(Ipv6EndPointDemux& demux,
+                                  Ipv6Address daddr,
+                                  uint16_t dport,
+                                  Ipv6Address saddr,
+                                  uint16_t sport)
+{
+    Ipv6EndPointDemux::EndPoints endPoints = demux.Lookup(daddr, dport, saddr, sport, nullptr);
+    return endPoints.empty() ? nullptr : endPoints.front();
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ipv6EndPointDemux demux;
+
+    Ipv6Address local("2001:db8::1");
+    Ipv6Address other("2001:db8::fe");
+
+    Ipv6EndPoint* listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listener allocation failed");
+
+    std::vector<Ipv6EndPoint*> connections;
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        connections.push_back(
+            demux.Allocate(nullptr, local, 80, Ipv6Address("2001:db8:1::1"), 1000 + i));
+        NS_TEST_ASSERT_MSG_NE(connections.back(), nullptr, "Connection allocation failed");
+    }
+
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Lookup(demux, local, 80, Ipv6Address("2001:db8:1::1"), 1000 + i),
+                              connections[i],
+                              "Connection not found");
+    }
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, other, 80, Ipv6Address("2001:db8:1::1"), 1000),
+                          listener,
+                          "Unknown destination not delivered to the wildcard listener");
+
+    demux.DeAllocate(connections[0]);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, local, 80, Ipv6Address("2001:db8:1::1"), 1000),
+                          listener,
+                          "Deallocated connection still found");
+
+    Ipv6EndPoint* client = demux.Allocate();
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Ephemeral allocation failed");
+    uint16_t port = client->GetLocalPort();
+    client->SetPeer(local, 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, other, port, local, 80), client, "Connected client lost");
+    client->SetLocalPort(port + 1);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(port), false, "Old port still in use");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, other, port + 1, local, 80),
+                          client,
+                          "Client lost after a local port change");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief EndPoint demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase(), TestCase::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase(), TestCase::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
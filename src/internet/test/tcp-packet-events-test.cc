@@ -0,0 +1,300 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "tcp-error-model.h"
+#include "tcp-general-test.h"
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include <map>
+#include <set>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpPacketEventsTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Behaves as NewReno, and forwards the per-segment events to the test.
+ */
+class PacketEventsCongControl : public TcpNewReno
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /// Callback invoked on each per-segment event
+    typedef Callback<void, SequenceNumber32, uint32_t, Time> EventCallback;
+
+    PacketEventsCongControl()
+    {
+    }
+
+    /**
+     * \brief Set the callbacks to be used on the per-segment events.
+     * \param sent Callback for OnPacketSent
+     * \param acked Callback for OnPacketAcked
+     * \param lost Callback for OnPacketLost
+     */
+    void SetCallbacks(EventCallback sent, EventCallback acked, EventCallback lost)
+    {
+        m_sent = sent;
+        m_acked = acked;
+        m_lost = lost;
+    }
+
+    bool HasPacketEvents() const override
+    {
+        return true;
+    }
+
+    void OnPacketSent(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t size,
+                      const Time& sentTime) override
+    {
+        m_sent(seq, size, sentTime);
+    }
+
+    void OnPacketAcked(Ptr<TcpSocketState> tcb,
+                       SequenceNumber32 seq,
+                       uint32_t size,
+                       const Time& sentTime) override
+    {
+        m_acked(seq, size, sentTime);
+    }
+
+    void OnPacketLost(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t size,
+                      const Time& sentTime) override
+    {
+        m_lost(seq, size, sentTime);
+    }
+
+  private:
+    EventCallback m_sent;  //!< Callback for OnPacketSent
+    EventCallback m_acked; //!< Callback for OnPacketAcked
+    EventCallback m_lost;  //!< Callback for OnPacketLost
+};
+
+TypeId
+PacketEventsCongControl::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::PacketEventsCongControl")
+                            .SetParent<TcpNewReno>()
+                            .AddConstructor<PacketEventsCongControl>()
+                            .SetGroupName("Internet");
+    return tid;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the per-segment events of TcpCongestionOps
+ *
+ * Some segments are dropped by the receiver. The test checks that every
+ * byte of the application is reported as acked exactly once, that the
+ * dropped segments are reported as lost with the time of their previous
+ * transmission, and that the acked segments carry the time of their last
+ * transmission. When the retransmission of a segment is dropped too, the
+ * segments SACKed before the resulting RTO must not be reported as acked
+ * again after it.
+ */
+class TcpPacketEventsTest : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param sackEnabled Enable or disable SACK
+     * \param toDrop Sequence numbers to drop (once)
+     * \param desc Test description.
+     * \param expectRto Whether the drops cause an RTO
+     */
+    TcpPacketEventsTest(bool sackEnabled,
+                        const std::vector<uint32_t>& toDrop,
+                        const std::string& desc,
+                        bool expectRto = false);
+
+  protected:
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+    Ptr<ErrorModel> CreateReceiverErrorModel() override;
+    void ConfigureEnvironment() override;
+    void AfterRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    /**
+     * \brief Called when a segment is sent.
+     * \param seq sequence number
+     * \param size segment size
+     * \param sentTime transmission time
+     */
+    void Sent(SequenceNumber32 seq, uint32_t size, Time sentTime);
+
+    /**
+     * \brief Called when a segment is acked.
+     * \param seq sequence number
+     * \param size segment size
+     * \param sentTime last transmission time
+     */
+    void Acked(SequenceNumber32 seq, uint32_t size, Time sentTime);
+
+    /**
+     * \brief Called when a segment is lost.
+     * \param seq sequence number
+     * \param size segment size
+     * \param sentTime previous transmission time
+     */
+    void Lost(SequenceNumber32 seq, uint32_t size, Time sentTime);
+
+    bool m_sackEnabled;              //!< Sack option enabled or disabled
+    std::vector<uint32_t> m_toDrop;  //!< List of SequenceNumber to drop
+    std::map<uint32_t, Time> m_sent; //!< Last transmission time of each segment
+    std::set<uint32_t> m_acked;      //!< Acked segments
+    std::set<uint32_t> m_lost;       //!< Lost segments
+    uint32_t m_bytesAcked{0};        //!< Bytes reported as acked
+    bool m_expectRto;                //!< Whether the drops cause an RTO
+    uint32_t m_rtoCount{0};          //!< Number of RTOs of the sender
+};
+
+TcpPacketEventsTest::TcpPacketEventsTest(bool sackEnabled,
+                                         const std::vector<uint32_t>& toDrop,
+                                         const std::string& desc,
+                                         bool expectRto)
+    : TcpGeneralTest(desc),
+      m_sackEnabled(sackEnabled),
+      m_toDrop(toDrop),
+      m_expectRto(expectRto)
+{
+}
+
+void
+TcpPacketEventsTest::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(20);
+    SetPropagationDelay(MilliSeconds(10));
+
+    Config::SetDefault("ns3::TcpSocketBase::Sack", BooleanValue(m_sackEnabled));
+}
+
+Ptr<TcpSocketMsgBase>
+TcpPacketEventsTest::CreateSenderSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> s = TcpGeneralTest::CreateSenderSocket(node);
+    Ptr<PacketEventsCongControl> congCtl = CreateObject<PacketEventsCongControl>();
+    congCtl->SetCallbacks(MakeCallback(&TcpPacketEventsTest::Sent, this),
+                          MakeCallback(&TcpPacketEventsTest::Acked, this),
+                          MakeCallback(&TcpPacketEventsTest::Lost, this));
+    s->SetCongestionControlAlgorithm(congCtl);
+    return s;
+}
+
+Ptr<ErrorModel>
+TcpPacketEventsTest::CreateReceiverErrorModel()
+{
+    Ptr<TcpSeqErrorModel> errorModel = CreateObject<TcpSeqErrorModel>();
+    for (uint32_t seq : m_toDrop)
+    {
+        errorModel->AddSeqToKill(SequenceNumber32(seq));
+    }
+    return errorModel;
+}
+
+void
+TcpPacketEventsTest::Sent(SequenceNumber32 seq, uint32_t size, Time sentTime)
+{
+    NS_TEST_EXPECT_MSG_EQ(sentTime, Simulator::Now(), "Sent time is not the current time");
+    NS_TEST_EXPECT_MSG_EQ(m_acked.count(seq.GetValue()), 0, "Acked segment sent again");
+    m_sent[seq.GetValue()] = sentTime;
+}
+
+void
+TcpPacketEventsTest::Acked(SequenceNumber32 seq, uint32_t size, Time sentTime)
+{
+    NS_TEST_ASSERT_MSG_EQ(m_sent.count(seq.GetValue()), 1, "Acked segment never sent");
+    NS_TEST_EXPECT_MSG_EQ(sentTime, m_sent[seq.GetValue()], "Wrong last sent time");
+    NS_TEST_EXPECT_MSG_EQ(m_acked.insert(seq.GetValue()).second, true, "Segment acked twice");
+    m_bytesAcked += size;
+}
+
+void
+TcpPacketEventsTest::Lost(SequenceNumber32 seq, uint32_t size, Time sentTime)
+{
+    NS_TEST_ASSERT_MSG_EQ(m_sent.count(seq.GetValue()), 1, "Lost segment never sent");
+    NS_TEST_EXPECT_MSG_EQ(sentTime, m_sent[seq.GetValue()], "Wrong previous sent time");
+    NS_TEST_EXPECT_MSG_EQ(m_acked.count(seq.GetValue()), 0, "Acked segment lost");
+    m_lost.insert(seq.GetValue());
+}
+
+void
+TcpPacketEventsTest::AfterRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who)
+{
+    if (who == SENDER)
+    {
+        m_rtoCount++;
+    }
+}
+
+void
+TcpPacketEventsTest::FinalChecks()
+{
+    NS_TEST_EXPECT_MSG_EQ((m_rtoCount > 0), m_expectRto, "Unexpected RTO count " << m_rtoCount);
+    NS_TEST_EXPECT_MSG_EQ(m_bytesAcked, 20 * 500, "Not all the bytes have been reported as acked");
+    NS_TEST_EXPECT_MSG_EQ(m_acked.size(), m_sent.size(), "Not all the segments have been acked");
+    for (uint32_t seq : m_toDrop)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_lost.count(seq), 1, "Dropped segment " << seq << " not lost");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Per-segment congestion control events TestSuite.
+ */
+class TcpPacketEventsTestSuite : public TestSuite
+{
+  public:
+    TcpPacketEventsTestSuite()
+        : TestSuite("tcp-packet-events-test", UNIT)
+    {
+        AddTestCase(new TcpPacketEventsTest(true, {}, "Events without losses"), TestCase::QUICK);
+        AddTestCase(new TcpPacketEventsTest(true, {2001, 4001}, "Events with losses and SACK"),
+                    TestCase::QUICK);
+        AddTestCase(new TcpPacketEventsTest(false, {2001}, "Events with losses, no SACK"),
+                    TestCase::QUICK);
+        AddTestCase(new TcpPacketEventsTest(true,
+                                            {2001, 2001},
+                                            "Events with an RTO after SACKed segments",
+                                            true),
+                    TestCase::QUICK);
+    }
+};
+
+static TcpPacketEventsTestSuite g_tcpPacketEventsTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,152 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "tcp-error-model.h"
+#include "tcp-general-test.h"
+
+#include "ns3/log.h"
+#include "ns3/tcp-option-sack.h"
+
+#include <set>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpSackAllocationTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the SACK options are not created anew for each ACK.
+ *
+ * Every other segment of the sender is lost, so the receiver sends a run
+ * of ACKs with SACK blocks. The receiver builds all of them in the same
+ * TcpOptionSack, since no header holds the option of an ACK once it is
+ * sent; the sender deserializes all of them into the same TcpOptionSack,
+ * taken from the cache of TcpHeader::Deserialize.
+ */
+class TcpSackAllocationTest : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param desc Description.
+     */
+    TcpSackAllocationTest(const std::string& desc);
+
+  protected:
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    Ptr<ErrorModel> CreateReceiverErrorModel() override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    std::set<const TcpOption*> m_sentOptions;     //!< SACK options sent by the receiver
+    std::set<const TcpOption*> m_receivedOptions; //!< SACK options received by the sender
+    uint32_t m_sentAcks;                          //!< Number of ACKs sent with SACK blocks
+    uint32_t m_receivedAcks;                      //!< Number of ACKs received with SACK blocks
+    uint32_t m_maxBlocks;                         //!< Largest number of SACK blocks in an ACK
+};
+
+TcpSackAllocationTest::TcpSackAllocationTest(const std::string& desc)
+    : TcpGeneralTest(desc),
+      m_sentAcks(0),
+      m_receivedAcks(0),
+      m_maxBlocks(0)
+{
+}
+
+void
+TcpSackAllocationTest::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(20);
+}
+
+void
+TcpSackAllocationTest::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 20);
+}
+
+Ptr<ErrorModel>
+TcpSackAllocationTest::CreateReceiverErrorModel()
+{
+    Ptr<TcpSeqErrorModel> errorModel = CreateObject<TcpSeqErrorModel>();
+    for (uint32_t i = 1; i < 12; i += 2)
+    {
+        errorModel->AddSeqToKill(SequenceNumber32(1 + i * 500));
+    }
+    return errorModel;
+}
+
+void
+TcpSackAllocationTest::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER && h.HasOption(TcpOption::SACK))
+    {
+        m_sentOptions.insert(PeekPointer(h.GetOption(TcpOption::SACK)));
+        m_sentAcks++;
+    }
+}
+
+void
+TcpSackAllocationTest::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == SENDER && h.HasOption(TcpOption::SACK))
+    {
+        Ptr<const TcpOptionSack> option =
+            DynamicCast<const TcpOptionSack>(h.GetOption(TcpOption::SACK));
+        m_receivedOptions.insert(PeekPointer(option));
+        m_maxBlocks = std::max(m_maxBlocks, option->GetNumSackBlocks());
+        m_receivedAcks++;
+    }
+}
+
+void
+TcpSackAllocationTest::FinalChecks()
+{
+    NS_TEST_ASSERT_MSG_GT(m_sentAcks, 5, "The losses should cause ACKs with SACK blocks");
+    NS_TEST_EXPECT_MSG_EQ(m_receivedAcks, m_sentAcks, "The ACKs are not lost");
+    // Three blocks fit in the option space next to the timestamps
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_maxBlocks, 3, "The ACKs should carry several SACK blocks");
+    NS_TEST_EXPECT_MSG_EQ(m_sentOptions.size(), 1, "The receiver should reuse its SACK option");
+    NS_TEST_EXPECT_MSG_EQ(m_receivedOptions.size(),
+                          1,
+                          "The sender should deserialize into the same SACK option");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TCP SACK allocation TestSuite
+ */
+class TcpSackAllocationTestSuite : public TestSuite
+{
+  public:
+    TcpSackAllocationTestSuite()
+        : TestSuite("tcp-sack-allocation", UNIT)
+    {
+        AddTestCase(new TcpSackAllocationTest("SACK options are reused across ACKs"),
+                    TestCase::QUICK);
+    }
+};
+
+static TcpSackAllocationTestSuite g_tcpSackAllocationTestSuite; //!< Static variable for test initialization
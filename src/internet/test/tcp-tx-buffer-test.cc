@@ -21,6 +21,7 @@
 #include "ns3/test.h"
 
 #include <limits>
+#include <set>
 
 using namespace ns3;
 
@@ -53,6 +54,10 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the lost count while SACK blocks arrive out of order */
+    void TestUpdateLostCount();
+    /** \brief Test the lost count when each SACK block ends where the previous one starts */
+    void TestHighestSackAdjacentBlocks();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -100,6 +105,20 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for the lost count:
+     *  -> segments are SACKed in an arbitrary order, and the lost bytes must
+     *     match the segments below the DupThresh-th highest SACKed segment.
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestUpdateLostCount, this);
+
+    /*
+     * Case for the highest SACKed segment:
+     *  -> each SACK block ends where the highest SACKed segment starts; the
+     *     highest SACKed segment must not move back to the new block.
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestHighestSackAdjacentBlocks, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -420,6 +439,105 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestUpdateLostCount()
+{
+    const uint32_t segmentSize = 100;
+    const uint32_t segments = 40;
+    const uint32_t dupThresh = 3;
+
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(dupThresh);
+    txBuf->Add(Create<Packet>(segmentSize * segments));
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, SequenceNumber32(1 + i * segmentSize));
+    }
+
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    std::set<uint32_t> sacked;
+
+    // Visit the segments in a scrambled order; one out of four is never SACKed
+    for (uint32_t n = 0; n < segments; ++n)
+    {
+        uint32_t i = (n * 17) % segments;
+        if (i % 4 == 0)
+        {
+            continue;
+        }
+        SequenceNumber32 begin(1 + i * segmentSize);
+        sack->ClearSackList();
+        sack->AddSackBlock(TcpOptionSack::SackBlock(begin, begin + segmentSize));
+        txBuf->Update(sack->GetSackList());
+        sacked.insert(i);
+
+        // Every segment below the DupThresh-th highest SACKed one is lost
+        uint32_t lost = 0;
+        if (sacked.size() >= dupThresh)
+        {
+            uint32_t threshold = *std::next(sacked.rbegin(), dupThresh - 1);
+            for (uint32_t j = 0; j < threshold; ++j)
+            {
+                if (sacked.count(j) == 0)
+                {
+                    lost += segmentSize;
+                }
+            }
+        }
+
+        NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(),
+                              sacked.size() * segmentSize,
+                              "Wrong sacked bytes after SACKing segment " << i);
+        NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(),
+                              lost,
+                              "Wrong lost bytes after SACKing segment " << i);
+        NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(),
+                              segments * segmentSize - sacked.size() * segmentSize - lost,
+                              "Wrong bytes in flight after SACKing segment " << i);
+    }
+}
+
+void
+TcpTxBufferTestCase::TestHighestSackAdjacentBlocks()
+{
+    const uint32_t segmentSize = 100;
+    const uint32_t segments = 10;
+
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    txBuf->Add(Create<Packet>(segmentSize * segments));
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, SequenceNumber32(1 + i * segmentSize));
+    }
+
+    // SACK the segments 9, 8 and 7, in this order
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    for (uint32_t i = segments - 1; i >= segments - 3; --i)
+    {
+        SequenceNumber32 begin(1 + i * segmentSize);
+        sack->ClearSackList();
+        sack->AddSackBlock(TcpOptionSack::SackBlock(begin, begin + segmentSize));
+        txBuf->Update(sack->GetSackList());
+    }
+
+    // Three segments are SACKed above the segments 0 to 6, which are lost
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 3 * segmentSize, "Wrong sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), 7 * segmentSize, "Wrong lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(SequenceNumber32(1 + 6 * segmentSize)),
+                          true,
+                          "The segment below the SACKed ones should be lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(SequenceNumber32(1 + 8 * segmentSize)),
+                          false,
+                          "A SACKed segment is not lost");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
@@ -0,0 +1,101 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// A LiteTransportSender sends at a constant rate over a point-to-point
+// bottleneck, and prints the datagrams acked and lost.
+//
+//   n0 ----------- n1
+//       10Mbps
+//        20ms
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/lite-transport-helper.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LiteTransportExample");
+
+/**
+ * Print the RTT samples.
+ *
+ * \param oldValue The old RTT.
+ * \param newValue The new RTT.
+ */
+static void
+RttTracer(Time oldValue, Time newValue)
+{
+    std::cout << Simulator::Now().GetSeconds() << " rtt " << newValue.GetMilliSeconds() << "ms"
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string rate = "12Mbps";
+    bool traceRtt = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("rate", "Sending rate", rate);
+    cmd.AddValue("traceRtt", "Print the RTT samples", traceRtt);
+    cmd.Parse(argc, argv);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("20ms"));
+    NetDeviceContainer devices = p2p.Install(nodes);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    uint16_t port = 4000;
+    LiteTransportReceiverHelper receiverHelper(port);
+    ApplicationContainer receiverApps = receiverHelper.Install(nodes.Get(1));
+    receiverApps.Start(Seconds(0));
+
+    LiteTransportSenderHelper senderHelper(interfaces.GetAddress(1), port);
+    senderHelper.SetRateController("ns3::LiteConstantRateController",
+                                   "DataRate",
+                                   StringValue(rate));
+    ApplicationContainer senderApps = senderHelper.Install(nodes.Get(0));
+    senderApps.Start(Seconds(1));
+    senderApps.Stop(Seconds(11));
+
+    Ptr<LiteTransportSender> sender = DynamicCast<LiteTransportSender>(senderApps.Get(0));
+    if (traceRtt)
+    {
+        sender->TraceConnectWithoutContext("Rtt", MakeCallback(&RttTracer));
+    }
+
+    Simulator::Stop(Seconds(12));
+    Simulator::Run();
+
+    std::cout << "Sent:  " << sender->GetSent() << " datagrams" << std::endl;
+    std::cout << "Acked: " << sender->GetAcked() << " datagrams" << std::endl;
+    std::cout << "Lost:  " << sender->GetLost() << " datagrams" << std::endl;
+    std::cout << "SRTT:  " << sender->GetSmoothedRtt().GetMilliSeconds() << "ms" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
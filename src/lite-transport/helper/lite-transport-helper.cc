@@ -0,0 +1,84 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "lite-transport-helper.h"
+
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+LiteTransportReceiverHelper::LiteTransportReceiverHelper(uint16_t port)
+{
+    m_factory.SetTypeId(LiteTransportReceiver::GetTypeId());
+    SetAttribute("Port", UintegerValue(port));
+}
+
+void
+LiteTransportReceiverHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+ApplicationContainer
+LiteTransportReceiverHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<Application> app = m_factory.Create<LiteTransportReceiver>();
+        (*i)->AddApplication(app);
+        apps.Add(app);
+    }
+    return apps;
+}
+
+LiteTransportSenderHelper::LiteTransportSenderHelper(Address ip, uint16_t port)
+{
+    m_factory.SetTypeId(LiteTransportSender::GetTypeId());
+    m_controllerFactory.SetTypeId(LiteConstantRateController::GetTypeId());
+    SetAttribute("RemoteAddress", AddressValue(ip));
+    SetAttribute("RemotePort", UintegerValue(port));
+}
+
+LiteTransportSenderHelper::LiteTransportSenderHelper(Address addr)
+{
+    m_factory.SetTypeId(LiteTransportSender::GetTypeId());
+    m_controllerFactory.SetTypeId(LiteConstantRateController::GetTypeId());
+    SetAttribute("RemoteAddress", AddressValue(addr));
+}
+
+void
+LiteTransportSenderHelper::SetAttribute(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+ApplicationContainer
+LiteTransportSenderHelper::Install(NodeContainer c) const
+{
+    ApplicationContainer apps;
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<LiteTransportSender> app = m_factory.Create<LiteTransportSender>();
+        app->SetRateController(m_controllerFactory.Create<LiteRateController>());
+        (*i)->AddApplication(app);
+        apps.Add(app);
+    }
+    return apps;
+}
+
+} // namespace ns3
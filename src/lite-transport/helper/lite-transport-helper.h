@@ -0,0 +1,135 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LITE_TRANSPORT_HELPER_H
+#define LITE_TRANSPORT_HELPER_H
+
+#include "ns3/application-container.h"
+#include "ns3/lite-transport-receiver.h"
+#include "ns3/lite-transport-sender.h"
+#include "ns3/node-container.h"
+#include "ns3/object-factory.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup lite-transport
+ * \brief Create LiteTransportReceiver applications
+ */
+class LiteTransportReceiverHelper
+{
+  public:
+    /**
+     * \param port The port the receiver will wait on for incoming datagrams
+     */
+    LiteTransportReceiverHelper(uint16_t port);
+
+    /**
+     * Record an attribute to be set in each Application after it is is created.
+     *
+     * \param name the name of the attribute to set
+     * \param value the value of the attribute to set
+     */
+    void SetAttribute(std::string name, const AttributeValue& value);
+
+    /**
+     * Create one receiver application on each of the Nodes in the
+     * NodeContainer.
+     *
+     * \param c The nodes on which to create the Applications.
+     * \returns The applications created, one Application per Node in the
+     *          NodeContainer.
+     */
+    ApplicationContainer Install(NodeContainer c) const;
+
+  private:
+    ObjectFactory m_factory; //!< Object factory.
+};
+
+/**
+ * \ingroup lite-transport
+ * \brief Create LiteTransportSender applications
+ *
+ * Each sender gets its own rate controller, created from the type set with
+ * SetRateController.
+ */
+class LiteTransportSenderHelper
+{
+  public:
+    /**
+     * Use this variant with addresses that do not include a port value
+     * (e.g., Ipv4Address and Ipv6Address).
+     *
+     * \param ip The IP address of the receiver
+     * \param port The port number of the receiver
+     */
+    LiteTransportSenderHelper(Address ip, uint16_t port);
+
+    /**
+     * Use this variant with addresses that do include a port value
+     * (e.g., InetSocketAddress and Inet6SocketAddress).
+     *
+     * \param addr The address of the receiver
+     */
+    LiteTransportSenderHelper(Address addr);
+
+    /**
+     * Record an attribute to be set in each Application after it is is created.
+     *
+     * \param name the name of the attribute to set
+     * \param value the value of the attribute to set
+     */
+    void SetAttribute(std::string name, const AttributeValue& value);
+
+    /**
+     * \brief Set the type and the attributes of the rate controllers
+     *
+     * \tparam Ts \deduced Argument types
+     * \param type the type of the rate controller
+     * \param [in] args Name and AttributeValue pairs to set.
+     */
+    template <typename... Ts>
+    void SetRateController(std::string type, Ts&&... args);
+
+    /**
+     * Create one sender application on each of the input nodes
+     *
+     * \param c the nodes
+     * \returns the applications created, one application per input node.
+     */
+    ApplicationContainer Install(NodeContainer c) const;
+
+  private:
+    ObjectFactory m_factory;           //!< Object factory.
+    ObjectFactory m_controllerFactory; //!< Rate controller factory.
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename... Ts>
+void
+LiteTransportSenderHelper::SetRateController(std::string type, Ts&&... args)
+{
+    m_controllerFactory.SetTypeId(type);
+    m_controllerFactory.Set(std::forward<Ts>(args)...);
+}
+
+} // namespace ns3
+
+#endif /* LITE_TRANSPORT_HELPER_H */
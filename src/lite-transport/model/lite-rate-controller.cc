@@ -0,0 +1,98 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "lite-rate-controller.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LiteRateController");
+
+NS_OBJECT_ENSURE_REGISTERED(LiteRateController);
+
+TypeId
+LiteRateController::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LiteRateController").SetParent<Object>().SetGroupName("LiteTransport");
+    return tid;
+}
+
+LiteRateController::LiteRateController()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LiteRateController::~LiteRateController()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LiteRateController::OnPacketSent(Time sentTime, uint64_t packetNumber, uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << sentTime << packetNumber << bytes);
+}
+
+void
+LiteRateController::OnPacketAcked(Time eventTime, uint64_t packetNumber, uint32_t bytes, Time rtt)
+{
+    NS_LOG_FUNCTION(this << eventTime << packetNumber << bytes << rtt);
+}
+
+void
+LiteRateController::OnPacketLost(Time eventTime, uint64_t packetNumber, uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << eventTime << packetNumber << bytes);
+}
+
+NS_OBJECT_ENSURE_REGISTERED(LiteConstantRateController);
+
+TypeId
+LiteConstantRateController::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LiteConstantRateController")
+                            .SetParent<LiteRateController>()
+                            .SetGroupName("LiteTransport")
+                            .AddConstructor<LiteConstantRateController>()
+                            .AddAttribute("DataRate",
+                                          "The sending rate",
+                                          DataRateValue(DataRate("1Mbps")),
+                                          MakeDataRateAccessor(&LiteConstantRateController::m_rate),
+                                          MakeDataRateChecker());
+    return tid;
+}
+
+LiteConstantRateController::LiteConstantRateController()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LiteConstantRateController::~LiteConstantRateController()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+DataRate
+LiteConstantRateController::GetNextSendingRate(DataRate currentRate, Time now)
+{
+    NS_LOG_FUNCTION(this << currentRate << now);
+    return m_rate;
+}
+
+} // namespace ns3
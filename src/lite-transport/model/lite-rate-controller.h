@@ -0,0 +1,122 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LITE_RATE_CONTROLLER_H
+#define LITE_RATE_CONTROLLER_H
+
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+namespace ns3
+{
+
+/**
+ * \defgroup lite-transport Lite transport
+ *
+ * A datagram transport over UDP with QUIC-style packet numbers, ACK ranges
+ * and loss detection, whose sending rate is decided by a LiteRateController.
+ */
+
+/**
+ * \ingroup lite-transport
+ *
+ * \brief Rate controller of a LiteTransportSender
+ *
+ * The sender paces its datagrams at the rate returned by
+ * GetNextSendingRate, which is queried after every transmission with the
+ * same signature as the PCC rate controllers (PccRateController). Every
+ * datagram is then reported exactly once as either acked or lost, by its
+ * packet number; packet numbers are never reused, so monitor intervals can
+ * be accounted per packet without the ambiguity of retransmitted TCP
+ * sequence numbers.
+ */
+class LiteRateController : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LiteRateController();
+    ~LiteRateController() override;
+
+    /**
+     * \brief Get the rate to use for the next datagrams
+     *
+     * \param currentRate the rate in use
+     * \param now the current time
+     * \return the sending rate
+     */
+    virtual DataRate GetNextSendingRate(DataRate currentRate, Time now) = 0;
+
+    /**
+     * \brief A datagram has been sent
+     *
+     * \param sentTime the transmission time
+     * \param packetNumber the packet number
+     * \param bytes the datagram size
+     */
+    virtual void OnPacketSent(Time sentTime, uint64_t packetNumber, uint32_t bytes);
+
+    /**
+     * \brief A datagram has been acknowledged
+     *
+     * \param eventTime the time the ACK has been received
+     * \param packetNumber the packet number
+     * \param bytes the datagram size
+     * \param rtt the latest RTT sample of the connection
+     */
+    virtual void OnPacketAcked(Time eventTime, uint64_t packetNumber, uint32_t bytes, Time rtt);
+
+    /**
+     * \brief A datagram has been declared lost
+     *
+     * \param eventTime the time of the loss detection
+     * \param packetNumber the packet number
+     * \param bytes the datagram size
+     */
+    virtual void OnPacketLost(Time eventTime, uint64_t packetNumber, uint32_t bytes);
+};
+
+/**
+ * \ingroup lite-transport
+ *
+ * \brief A rate controller which keeps the rate constant
+ */
+class LiteConstantRateController : public LiteRateController
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LiteConstantRateController();
+    ~LiteConstantRateController() override;
+
+    DataRate GetNextSendingRate(DataRate currentRate, Time now) override;
+
+  private:
+    DataRate m_rate; //!< The sending rate
+};
+
+} // namespace ns3
+
+#endif /* LITE_RATE_CONTROLLER_H */
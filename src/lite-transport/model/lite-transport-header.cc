@@ -0,0 +1,193 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "lite-transport-header.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LiteTransportHeader");
+
+NS_OBJECT_ENSURE_REGISTERED(LiteTransportHeader);
+
+LiteTransportHeader::LiteTransportHeader()
+    : m_type(DATA),
+      m_packetNumber(0),
+      m_ackDelay(0)
+{
+}
+
+TypeId
+LiteTransportHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LiteTransportHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("LiteTransport")
+                            .AddConstructor<LiteTransportHeader>();
+    return tid;
+}
+
+TypeId
+LiteTransportHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+LiteTransportHeader::SetType(Type_t type)
+{
+    m_type = type;
+}
+
+LiteTransportHeader::Type_t
+LiteTransportHeader::GetType() const
+{
+    return m_type;
+}
+
+void
+LiteTransportHeader::SetPacketNumber(uint64_t packetNumber)
+{
+    m_packetNumber = packetNumber;
+}
+
+uint64_t
+LiteTransportHeader::GetPacketNumber() const
+{
+    return m_packetNumber;
+}
+
+void
+LiteTransportHeader::SetAckDelay(const Time& ackDelay)
+{
+    m_ackDelay = static_cast<uint32_t>(
+        std::min<int64_t>(ackDelay.GetMicroSeconds(), std::numeric_limits<uint32_t>::max()));
+}
+
+Time
+LiteTransportHeader::GetAckDelay() const
+{
+    return MicroSeconds(m_ackDelay);
+}
+
+void
+LiteTransportHeader::AddAckRange(uint64_t smallest, uint64_t largest)
+{
+    NS_ASSERT(smallest <= largest);
+    NS_ASSERT_MSG(m_ackRanges.empty() || largest + 1 < m_ackRanges.back().first,
+                  "Ranges must be added in descending order, without overlaps");
+    m_ackRanges.emplace_back(smallest, largest);
+}
+
+const std::vector<LiteTransportHeader::AckRange>&
+LiteTransportHeader::GetAckRanges() const
+{
+    return m_ackRanges;
+}
+
+uint64_t
+LiteTransportHeader::GetLargestAcked() const
+{
+    NS_ASSERT(!m_ackRanges.empty());
+    return m_ackRanges.front().second;
+}
+
+void
+LiteTransportHeader::Print(std::ostream& os) const
+{
+    if (m_type == DATA)
+    {
+        os << "DATA pn=" << m_packetNumber;
+        return;
+    }
+    os << "ACK delay=" << m_ackDelay << "us ranges=";
+    for (const auto& range : m_ackRanges)
+    {
+        os << "[" << range.first << "-" << range.second << "]";
+    }
+}
+
+uint32_t
+LiteTransportHeader::GetSerializedSize() const
+{
+    if (m_type == DATA)
+    {
+        return 1 + 8;
+    }
+    NS_ASSERT(!m_ackRanges.empty());
+    return 1 + 8 + 4 + 2 + 8 + (m_ackRanges.size() - 1) * 16;
+}
+
+void
+LiteTransportHeader::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteU8(m_type);
+    if (m_type == DATA)
+    {
+        i.WriteHtonU64(m_packetNumber);
+        return;
+    }
+
+    NS_ASSERT(!m_ackRanges.empty() && m_ackRanges.size() <= 0xffff);
+    i.WriteHtonU64(m_ackRanges.front().second);
+    i.WriteHtonU32(m_ackDelay);
+    i.WriteHtonU16(static_cast<uint16_t>(m_ackRanges.size() - 1));
+    i.WriteHtonU64(m_ackRanges.front().second - m_ackRanges.front().first);
+    for (std::size_t r = 1; r < m_ackRanges.size(); ++r)
+    {
+        // Gap between the previous smallest and the current largest, minus two
+        i.WriteHtonU64(m_ackRanges[r - 1].first - m_ackRanges[r].second - 2);
+        i.WriteHtonU64(m_ackRanges[r].second - m_ackRanges[r].first);
+    }
+}
+
+uint32_t
+LiteTransportHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    m_type = static_cast<Type_t>(i.ReadU8());
+    m_ackRanges.clear();
+    if (m_type == DATA)
+    {
+        m_packetNumber = i.ReadNtohU64();
+        return GetSerializedSize();
+    }
+    NS_ABORT_MSG_UNLESS(m_type == ACK, "Unknown lite transport datagram type " << +m_type);
+
+    uint64_t largest = i.ReadNtohU64();
+    m_ackDelay = i.ReadNtohU32();
+    uint16_t count = i.ReadNtohU16();
+    uint64_t length = i.ReadNtohU64();
+    m_ackRanges.emplace_back(largest - length, largest);
+    for (uint16_t r = 0; r < count; ++r)
+    {
+        uint64_t gap = i.ReadNtohU64();
+        length = i.ReadNtohU64();
+        largest = m_ackRanges.back().first - gap - 2;
+        m_ackRanges.emplace_back(largest - length, largest);
+    }
+    return GetSerializedSize();
+}
+
+} // namespace ns3
@@ -0,0 +1,129 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LITE_TRANSPORT_HEADER_H
+#define LITE_TRANSPORT_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/nstime.h"
+
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup lite-transport
+ *
+ * \brief Header of the lite transport datagrams
+ *
+ * Every datagram starts with a one byte type. DATA datagrams carry a
+ * packet number, which is never reused (retransmissions do not exist at
+ * this layer, lost data is simply reported as lost). ACK datagrams carry
+ * the received packet numbers as a list of ranges, encoded as in QUIC
+ * (RFC 9000, Section 19.3):
+ *
+ * \verbatim
+   DATA: | type (1) | packet number (8) |
+   ACK:  | type (1) | largest acked (8) | ack delay, us (4) | range count (2) |
+         | first range (8) | [gap (8) | range length (8)] ... |
+   \endverbatim
+ */
+class LiteTransportHeader : public Header
+{
+  public:
+    /// Datagram type
+    enum Type_t : uint8_t
+    {
+        DATA = 0, //!< Application data
+        ACK = 1   //!< Acknowledgment of received packet numbers
+    };
+
+    /// A range of packet numbers, [smallest, largest]
+    typedef std::pair<uint64_t, uint64_t> AckRange;
+
+    LiteTransportHeader();
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \param type the datagram type
+     */
+    void SetType(Type_t type);
+    /**
+     * \return the datagram type
+     */
+    Type_t GetType() const;
+
+    /**
+     * \param packetNumber the packet number of a DATA datagram
+     */
+    void SetPacketNumber(uint64_t packetNumber);
+    /**
+     * \return the packet number of a DATA datagram
+     */
+    uint64_t GetPacketNumber() const;
+
+    /**
+     * \param ackDelay the time elapsed between the reception of the
+     * largest acked packet and the transmission of the ACK
+     */
+    void SetAckDelay(const Time& ackDelay);
+    /**
+     * \return the ACK delay
+     */
+    Time GetAckDelay() const;
+
+    /**
+     * \brief Append a range of acknowledged packet numbers
+     *
+     * Ranges must be added in descending order and must not overlap or be
+     * adjacent to the previous one.
+     *
+     * \param smallest smallest packet number of the range
+     * \param largest largest packet number of the range
+     */
+    void AddAckRange(uint64_t smallest, uint64_t largest);
+    /**
+     * \return the acknowledged ranges, in descending order
+     */
+    const std::vector<AckRange>& GetAckRanges() const;
+    /**
+     * \return the largest acknowledged packet number
+     */
+    uint64_t GetLargestAcked() const;
+
+    TypeId GetInstanceTypeId() const override;
+    void Print(std::ostream& os) const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+
+  private:
+    Type_t m_type;                     //!< Datagram type
+    uint64_t m_packetNumber;           //!< Packet number (DATA)
+    uint32_t m_ackDelay;               //!< ACK delay in microseconds (ACK)
+    std::vector<AckRange> m_ackRanges; //!< Acknowledged ranges (ACK)
+};
+
+} // namespace ns3
+
+#endif /* LITE_TRANSPORT_HEADER_H */
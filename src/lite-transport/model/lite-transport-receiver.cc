@@ -0,0 +1,269 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "lite-transport-receiver.h"
+
+#include "lite-transport-header.h"
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LiteTransportReceiver");
+
+NS_OBJECT_ENSURE_REGISTERED(LiteTransportReceiver);
+
+TypeId
+LiteTransportReceiver::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LiteTransportReceiver")
+            .SetParent<Application>()
+            .SetGroupName("LiteTransport")
+            .AddConstructor<LiteTransportReceiver>()
+            .AddAttribute("Port",
+                          "Port on which we listen for incoming datagrams.",
+                          UintegerValue(100),
+                          MakeUintegerAccessor(&LiteTransportReceiver::m_port),
+                          MakeUintegerChecker<uint16_t>())
+            .AddAttribute("AckFrequency",
+                          "Number of received datagrams which trigger an ACK",
+                          UintegerValue(2),
+                          MakeUintegerAccessor(&LiteTransportReceiver::m_ackFrequency),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxAckDelay",
+                          "Maximum time an ACK is delayed",
+                          TimeValue(MilliSeconds(25)),
+                          MakeTimeAccessor(&LiteTransportReceiver::m_maxAckDelay),
+                          MakeTimeChecker())
+            .AddAttribute("MaxAckRanges",
+                          "Maximum number of ranges reported in an ACK",
+                          UintegerValue(32),
+                          MakeUintegerAccessor(&LiteTransportReceiver::m_maxAckRanges),
+                          MakeUintegerChecker<uint16_t>(1))
+            .AddTraceSource("Rx",
+                            "A DATA datagram has been received",
+                            MakeTraceSourceAccessor(&LiteTransportReceiver::m_rxTrace),
+                            "ns3::Packet::AddressTracedCallback");
+    return tid;
+}
+
+LiteTransportReceiver::LiteTransportReceiver()
+    : m_received(0),
+      m_totalRx(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LiteTransportReceiver::~LiteTransportReceiver()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LiteTransportReceiver::GetReceived() const
+{
+    return m_received;
+}
+
+uint64_t
+LiteTransportReceiver::GetTotalRx() const
+{
+    return m_totalRx;
+}
+
+void
+LiteTransportReceiver::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_socket = nullptr;
+    m_socket6 = nullptr;
+    m_peers.clear();
+    Application::DoDispose();
+}
+
+void
+LiteTransportReceiver::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_socket)
+    {
+        TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
+        m_socket = Socket::CreateSocket(GetNode(), tid);
+        InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(), m_port);
+        if (m_socket->Bind(local) == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+    }
+    m_socket->SetRecvCallback(MakeCallback(&LiteTransportReceiver::HandleRead, this));
+
+    if (!m_socket6)
+    {
+        TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
+        m_socket6 = Socket::CreateSocket(GetNode(), tid);
+        Inet6SocketAddress local = Inet6SocketAddress(Ipv6Address::GetAny(), m_port);
+        if (m_socket6->Bind(local) == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+    }
+    m_socket6->SetRecvCallback(MakeCallback(&LiteTransportReceiver::HandleRead, this));
+}
+
+void
+LiteTransportReceiver::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (auto& peer : m_peers)
+    {
+        peer.second.m_ackTimer.Cancel();
+    }
+    if (m_socket)
+    {
+        m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+    if (m_socket6)
+    {
+        m_socket6->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+}
+
+void
+LiteTransportReceiver::HandleRead(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    Ptr<Packet> packet;
+    Address from;
+    while ((packet = socket->RecvFrom(from)))
+    {
+        LiteTransportHeader header;
+        if (packet->PeekHeader(header) == 0 || header.GetType() != LiteTransportHeader::DATA)
+        {
+            NS_LOG_WARN("Discarding a datagram which is not DATA");
+            continue;
+        }
+
+        Peer& peer = m_peers[from];
+        peer.m_socket = socket;
+        uint64_t packetNumber = header.GetPacketNumber();
+        bool outOfOrder = !peer.m_rx.empty() && packetNumber != peer.m_largest + 1;
+        if (!Record(peer, packetNumber))
+        {
+            NS_LOG_LOGIC("Duplicated packet number " << packetNumber);
+            continue;
+        }
+        NS_LOG_LOGIC("Received packet number " << packetNumber << " from " << from);
+
+        m_received++;
+        m_totalRx += packet->GetSize();
+        m_rxTrace(packet, from);
+
+        if (packetNumber >= peer.m_largest)
+        {
+            peer.m_largest = packetNumber;
+            peer.m_largestRxTime = Simulator::Now();
+        }
+
+        // Losses and reordering are reported at once (RFC 9000, Section 13.2.1)
+        if (outOfOrder || ++peer.m_unacked >= m_ackFrequency)
+        {
+            SendAck(from);
+        }
+        else if (!peer.m_ackTimer.IsRunning())
+        {
+            peer.m_ackTimer =
+                Simulator::Schedule(m_maxAckDelay, &LiteTransportReceiver::SendAck, this, from);
+        }
+    }
+}
+
+bool
+LiteTransportReceiver::Record(Peer& peer, uint64_t packetNumber)
+{
+    std::map<uint64_t, uint64_t>::iterator next = peer.m_rx.upper_bound(packetNumber);
+    std::map<uint64_t, uint64_t>::iterator prev = next;
+    if (prev != peer.m_rx.begin())
+    {
+        --prev;
+        if (prev->second >= packetNumber)
+        {
+            return false;
+        }
+        if (prev->second + 1 == packetNumber)
+        {
+            prev->second = packetNumber;
+            if (next != peer.m_rx.end() && next->first == packetNumber + 1)
+            {
+                prev->second = next->second;
+                peer.m_rx.erase(next);
+            }
+            return true;
+        }
+    }
+
+    if (next != peer.m_rx.end() && next->first == packetNumber + 1)
+    {
+        uint64_t largest = next->second;
+        peer.m_rx.erase(next);
+        peer.m_rx.emplace(packetNumber, largest);
+    }
+    else
+    {
+        peer.m_rx.emplace(packetNumber, packetNumber);
+    }
+
+    // Forget the oldest ranges, which are not reported anymore
+    while (peer.m_rx.size() > m_maxAckRanges)
+    {
+        peer.m_rx.erase(peer.m_rx.begin());
+    }
+    return true;
+}
+
+void
+LiteTransportReceiver::SendAck(Address from)
+{
+    NS_LOG_FUNCTION(this << from);
+
+    Peer& peer = m_peers[from];
+    peer.m_ackTimer.Cancel();
+    peer.m_unacked = 0;
+
+    LiteTransportHeader header;
+    header.SetType(LiteTransportHeader::ACK);
+    header.SetAckDelay(Simulator::Now() - peer.m_largestRxTime);
+    for (auto it = peer.m_rx.rbegin(); it != peer.m_rx.rend(); ++it)
+    {
+        header.AddAckRange(it->first, it->second);
+    }
+
+    Ptr<Packet> ack = Create<Packet>();
+    ack->AddHeader(header);
+    NS_LOG_LOGIC("Sending " << header);
+    peer.m_socket->SendTo(ack, 0, from);
+}
+
+} // namespace ns3
@@ -0,0 +1,125 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LITE_TRANSPORT_RECEIVER_H
+#define LITE_TRANSPORT_RECEIVER_H
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
+
+#include <map>
+
+namespace ns3
+{
+
+class Socket;
+class Packet;
+
+/**
+ * \ingroup lite-transport
+ *
+ * \brief Receiver side of the lite transport
+ *
+ * The receiver records the packet numbers of the DATA datagrams as ranges,
+ * and acknowledges them to the sender with an ACK datagram carrying up to
+ * MaxAckRanges ranges, the most recent first. An ACK is sent every
+ * AckFrequency received datagrams, when a datagram is received out of
+ * order, or at the latest MaxAckDelay after the first unacknowledged
+ * datagram.
+ *
+ * The receiver serves any number of senders; the state of each sender is
+ * kept by address.
+ */
+class LiteTransportReceiver : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LiteTransportReceiver();
+    ~LiteTransportReceiver() override;
+
+    /**
+     * \return the number of DATA datagrams received (without duplicates)
+     */
+    uint64_t GetReceived() const;
+
+    /**
+     * \return the total bytes received in DATA datagrams (without duplicates)
+     */
+    uint64_t GetTotalRx() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// State of the packet numbers received from a sender
+    struct Peer
+    {
+        Ptr<Socket> m_socket;              //!< Socket to reply to the sender
+        std::map<uint64_t, uint64_t> m_rx; //!< Received ranges, smallest -> largest
+        uint64_t m_largest{0};             //!< Largest received packet number
+        Time m_largestRxTime;              //!< Reception time of the largest
+        uint32_t m_unacked{0};             //!< Datagrams received since the last ACK
+        EventId m_ackTimer;                //!< ACK timer
+    };
+
+    /**
+     * \brief Handle a packet reception.
+     * \param socket the socket the packet was received from
+     */
+    void HandleRead(Ptr<Socket> socket);
+
+    /**
+     * \brief Record a received packet number
+     * \param peer the sender state
+     * \param packetNumber the packet number
+     * \return false if the packet number was a duplicate
+     */
+    bool Record(Peer& peer, uint64_t packetNumber);
+
+    /**
+     * \brief Send an ACK to a sender
+     * \param from the sender address
+     */
+    void SendAck(Address from);
+
+    uint16_t m_port;                 //!< Port on which we listen
+    uint32_t m_ackFrequency;         //!< Datagrams received before sending an ACK
+    Time m_maxAckDelay;              //!< Maximum time an ACK is delayed
+    uint16_t m_maxAckRanges;         //!< Maximum number of ranges in an ACK
+    Ptr<Socket> m_socket;            //!< IPv4 socket
+    Ptr<Socket> m_socket6;           //!< IPv6 socket
+    std::map<Address, Peer> m_peers; //!< State of each sender
+    uint64_t m_received;             //!< Number of received datagrams
+    uint64_t m_totalRx;              //!< Number of received bytes
+
+    /// Traced Callback: received packets, source address.
+    TracedCallback<Ptr<const Packet>, const Address&> m_rxTrace;
+};
+
+} // namespace ns3
+
+#endif /* LITE_TRANSPORT_RECEIVER_H */
@@ -0,0 +1,569 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "lite-transport-sender.h"
+
+#include "lite-transport-header.h"
+
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LiteTransportSender");
+
+NS_OBJECT_ENSURE_REGISTERED(LiteTransportSender);
+
+/// Timer granularity, as in RFC 9002
+static const Time kGranularity = MilliSeconds(1);
+
+TypeId
+LiteTransportSender::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LiteTransportSender")
+            .SetParent<Application>()
+            .SetGroupName("LiteTransport")
+            .AddConstructor<LiteTransportSender>()
+            .AddAttribute("RemoteAddress",
+                          "The destination Address of the outbound datagrams",
+                          AddressValue(),
+                          MakeAddressAccessor(&LiteTransportSender::m_peerAddress),
+                          MakeAddressChecker())
+            .AddAttribute("RemotePort",
+                          "The destination port of the outbound datagrams",
+                          UintegerValue(100),
+                          MakeUintegerAccessor(&LiteTransportSender::m_peerPort),
+                          MakeUintegerChecker<uint16_t>())
+            .AddAttribute("PacketSize",
+                          "Size of the DATA datagrams, including the 9 bytes header.",
+                          UintegerValue(1200),
+                          MakeUintegerAccessor(&LiteTransportSender::m_size),
+                          MakeUintegerChecker<uint32_t>(9, 65507))
+            .AddAttribute("MaxBytes",
+                          "The total number of bytes to send. "
+                          "Once these bytes are sent, no data is sent again. "
+                          "The value zero means that there is no limit.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LiteTransportSender::m_maxBytes),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("InitialRate",
+                          "The current rate given to the rate controller for the first datagram",
+                          DataRateValue(DataRate("1Mbps")),
+                          MakeDataRateAccessor(&LiteTransportSender::m_initialRate),
+                          MakeDataRateChecker())
+            .AddAttribute("RateController",
+                          "The rate controller (a constant rate controller if not set)",
+                          PointerValue(),
+                          MakePointerAccessor(&LiteTransportSender::m_controller),
+                          MakePointerChecker<LiteRateController>())
+            .AddAttribute("InitialRtt",
+                          "The RTT used before the first sample",
+                          TimeValue(MilliSeconds(333)),
+                          MakeTimeAccessor(&LiteTransportSender::m_initialRtt),
+                          MakeTimeChecker())
+            .AddAttribute("PacketThreshold",
+                          "Number of later packet numbers acked before declaring a loss",
+                          UintegerValue(3),
+                          MakeUintegerAccessor(&LiteTransportSender::m_packetThreshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("TimeThreshold",
+                          "Multiple of the RTT after which a datagram is declared lost",
+                          DoubleValue(9.0 / 8),
+                          MakeDoubleAccessor(&LiteTransportSender::m_timeThreshold),
+                          MakeDoubleChecker<double>(1.0))
+            .AddAttribute("MaxAckDelay",
+                          "Maximum delay of the ACKs of the receiver",
+                          TimeValue(MilliSeconds(25)),
+                          MakeTimeAccessor(&LiteTransportSender::m_maxAckDelay),
+                          MakeTimeChecker())
+            .AddTraceSource("SendingRate",
+                            "The current sending rate",
+                            MakeTraceSourceAccessor(&LiteTransportSender::m_rate),
+                            "ns3::TracedValueCallback::DataRate")
+            .AddTraceSource("Rtt",
+                            "Latest RTT sample",
+                            MakeTraceSourceAccessor(&LiteTransportSender::m_latestRtt),
+                            "ns3::TracedValueCallback::Time")
+            .AddTraceSource("Tx",
+                            "A datagram has been sent",
+                            MakeTraceSourceAccessor(&LiteTransportSender::m_txTrace),
+                            "ns3::LiteTransportSender::PacketTracedCallback")
+            .AddTraceSource("Acked",
+                            "A datagram has been acked",
+                            MakeTraceSourceAccessor(&LiteTransportSender::m_ackedTrace),
+                            "ns3::LiteTransportSender::PacketTracedCallback")
+            .AddTraceSource("Lost",
+                            "A datagram has been declared lost",
+                            MakeTraceSourceAccessor(&LiteTransportSender::m_lostTrace),
+                            "ns3::LiteTransportSender::PacketTracedCallback");
+    return tid;
+}
+
+LiteTransportSender::LiteTransportSender()
+    : m_firstPacketNumber(0),
+      m_nextPacketNumber(0),
+      m_largestAcked(0),
+      m_hasRttSample(false),
+      m_bytesInFlight(0),
+      m_lossTime(Time::Max()),
+      m_ptoCount(0),
+      m_totalTx(0),
+      m_acked(0),
+      m_lost(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LiteTransportSender::~LiteTransportSender()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LiteTransportSender::SetRemote(Address ip, uint16_t port)
+{
+    NS_LOG_FUNCTION(this << ip << port);
+    m_peerAddress = ip;
+    m_peerPort = port;
+}
+
+void
+LiteTransportSender::SetRemote(Address addr)
+{
+    NS_LOG_FUNCTION(this << addr);
+    m_peerAddress = addr;
+}
+
+void
+LiteTransportSender::SetRateController(Ptr<LiteRateController> controller)
+{
+    NS_LOG_FUNCTION(this << controller);
+    m_controller = controller;
+}
+
+Ptr<LiteRateController>
+LiteTransportSender::GetRateController() const
+{
+    return m_controller;
+}
+
+uint64_t
+LiteTransportSender::GetTotalTx() const
+{
+    return m_totalTx;
+}
+
+uint64_t
+LiteTransportSender::GetSent() const
+{
+    return m_nextPacketNumber;
+}
+
+uint64_t
+LiteTransportSender::GetAcked() const
+{
+    return m_acked;
+}
+
+uint64_t
+LiteTransportSender::GetLost() const
+{
+    return m_lost;
+}
+
+Time
+LiteTransportSender::GetSmoothedRtt() const
+{
+    return m_hasRttSample ? m_smoothedRtt : m_initialRtt;
+}
+
+void
+LiteTransportSender::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_socket = nullptr;
+    m_controller = nullptr;
+    m_sentPackets.clear();
+    Application::DoDispose();
+}
+
+void
+LiteTransportSender::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_socket)
+    {
+        TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
+        m_socket = Socket::CreateSocket(GetNode(), tid);
+        if (Ipv4Address::IsMatchingType(m_peerAddress))
+        {
+            if (m_socket->Bind() == -1)
+            {
+                NS_FATAL_ERROR("Failed to bind socket");
+            }
+            m_socket->Connect(
+                InetSocketAddress(Ipv4Address::ConvertFrom(m_peerAddress), m_peerPort));
+        }
+        else if (Ipv6Address::IsMatchingType(m_peerAddress))
+        {
+            if (m_socket->Bind6() == -1)
+            {
+                NS_FATAL_ERROR("Failed to bind socket");
+            }
+            m_socket->Connect(
+                Inet6SocketAddress(Ipv6Address::ConvertFrom(m_peerAddress), m_peerPort));
+        }
+        else if (InetSocketAddress::IsMatchingType(m_peerAddress))
+        {
+            if (m_socket->Bind() == -1)
+            {
+                NS_FATAL_ERROR("Failed to bind socket");
+            }
+            m_socket->Connect(m_peerAddress);
+        }
+        else if (Inet6SocketAddress::IsMatchingType(m_peerAddress))
+        {
+            if (m_socket->Bind6() == -1)
+            {
+                NS_FATAL_ERROR("Failed to bind socket");
+            }
+            m_socket->Connect(m_peerAddress);
+        }
+        else
+        {
+            NS_ASSERT_MSG(false, "Incompatible address type: " << m_peerAddress);
+        }
+    }
+    m_socket->SetRecvCallback(MakeCallback(&LiteTransportSender::HandleRead, this));
+
+    if (!m_controller)
+    {
+        m_controller = CreateObject<LiteConstantRateController>();
+    }
+    m_rate = m_initialRate;
+    m_sendEvent = Simulator::ScheduleNow(&LiteTransportSender::Send, this);
+}
+
+void
+LiteTransportSender::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEvent.Cancel();
+    m_lossTimer.Cancel();
+    if (m_socket)
+    {
+        m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+}
+
+void
+LiteTransportSender::Send()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_maxBytes > 0 && m_totalTx >= m_maxBytes)
+    {
+        NS_LOG_LOGIC("All the bytes have been sent");
+        return;
+    }
+
+    Time now = Simulator::Now();
+    m_rate = m_controller->GetNextSendingRate(m_rate, now);
+    SendDatagram(m_size);
+    m_sendEvent = Simulator::Schedule(m_rate.Get().CalculateBytesTxTime(m_size),
+                                      &LiteTransportSender::Send,
+                                      this);
+}
+
+void
+LiteTransportSender::SendDatagram(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+
+    LiteTransportHeader header;
+    header.SetPacketNumber(m_nextPacketNumber);
+    Ptr<Packet> p = Create<Packet>(size - header.GetSerializedSize());
+    p->AddHeader(header);
+    if (m_socket->Send(p) < 0)
+    {
+        // Still accounted for: it will be declared lost
+        NS_LOG_WARN("Error sending packet number " << m_nextPacketNumber);
+    }
+
+    Time now = Simulator::Now();
+    if (m_sentPackets.empty())
+    {
+        m_firstPacketNumber = m_nextPacketNumber;
+    }
+    m_sentPackets.push_back({now, size, true});
+    m_bytesInFlight += size;
+    m_totalTx += size;
+    m_lastSentTime = now;
+
+    m_controller->OnPacketSent(now, m_nextPacketNumber, size);
+    m_txTrace(m_nextPacketNumber, size);
+    m_nextPacketNumber++;
+
+    if (!m_lossTimer.IsRunning())
+    {
+        SetLossDetectionTimer();
+    }
+}
+
+void
+LiteTransportSender::HandleRead(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    Ptr<Packet> packet;
+    Address from;
+    while ((packet = socket->RecvFrom(from)))
+    {
+        LiteTransportHeader header;
+        if (packet->PeekHeader(header) == 0 || header.GetType() != LiteTransportHeader::ACK)
+        {
+            NS_LOG_WARN("Discarding a datagram which is not an ACK");
+            continue;
+        }
+        ProcessAck(header);
+    }
+}
+
+void
+LiteTransportSender::ProcessAck(const LiteTransportHeader& header)
+{
+    NS_LOG_FUNCTION(this << header);
+
+    Time now = Simulator::Now();
+    uint64_t largest = header.GetLargestAcked();
+    if (largest >= m_nextPacketNumber)
+    {
+        NS_LOG_WARN("ACK of the packet number " << largest << " which has not been sent");
+        return;
+    }
+    m_largestAcked = m_acked > 0 ? std::max(m_largestAcked, largest) : largest;
+
+    if (m_sentPackets.empty() || largest < m_firstPacketNumber)
+    {
+        return;
+    }
+
+    // The RTT is sampled if the largest packet number is newly acked
+    const SentPacket& largestPacket = m_sentPackets[largest - m_firstPacketNumber];
+    if (largestPacket.m_inFlight)
+    {
+        UpdateRtt(now - largestPacket.m_sentTime, header.GetAckDelay());
+    }
+
+    // Report in ascending packet number order
+    bool newlyAcked = false;
+    const std::vector<LiteTransportHeader::AckRange>& ranges = header.GetAckRanges();
+    for (auto range = ranges.rbegin(); range != ranges.rend(); ++range)
+    {
+        if (range->second < m_firstPacketNumber)
+        {
+            continue;
+        }
+        for (uint64_t pn = std::max(range->first, m_firstPacketNumber); pn <= range->second; ++pn)
+        {
+            SentPacket& packet = m_sentPackets[pn - m_firstPacketNumber];
+            if (!packet.m_inFlight)
+            {
+                continue;
+            }
+            packet.m_inFlight = false;
+            m_bytesInFlight -= packet.m_size;
+            m_acked++;
+            newlyAcked = true;
+            m_controller->OnPacketAcked(now, pn, packet.m_size, m_latestRtt);
+            m_ackedTrace(pn, packet.m_size);
+        }
+    }
+
+    if (newlyAcked)
+    {
+        m_ptoCount = 0;
+    }
+    DetectLostPackets();
+    DiscardHead();
+    SetLossDetectionTimer();
+}
+
+void
+LiteTransportSender::UpdateRtt(Time latestRtt, Time ackDelay)
+{
+    NS_LOG_FUNCTION(this << latestRtt << ackDelay);
+
+    m_latestRtt = latestRtt;
+    if (!m_hasRttSample)
+    {
+        m_hasRttSample = true;
+        m_minRtt = latestRtt;
+        m_smoothedRtt = latestRtt;
+        m_rttVar = latestRtt / 2;
+        return;
+    }
+
+    m_minRtt = Min(m_minRtt, latestRtt);
+    ackDelay = Min(ackDelay, m_maxAckDelay);
+    Time adjustedRtt = latestRtt;
+    if (latestRtt >= m_minRtt + ackDelay)
+    {
+        adjustedRtt = latestRtt - ackDelay;
+    }
+    m_rttVar = (m_rttVar * 3 + Abs(m_smoothedRtt - adjustedRtt)) / 4;
+    m_smoothedRtt = (m_smoothedRtt * 7 + adjustedRtt) / 8;
+}
+
+void
+LiteTransportSender::DetectLostPackets()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_lossTime = Time::Max();
+    if (m_acked == 0 || m_sentPackets.empty())
+    {
+        return;
+    }
+
+    Time now = Simulator::Now();
+    Time lossDelay = Max(Max(m_latestRtt.Get(), GetSmoothedRtt()) * m_timeThreshold, kGranularity);
+    Time lostSendTime = now - lossDelay;
+
+    uint64_t pn = m_firstPacketNumber;
+    for (auto it = m_sentPackets.begin(); it != m_sentPackets.end() && pn < m_largestAcked;
+         ++it, ++pn)
+    {
+        if (!it->m_inFlight)
+        {
+            continue;
+        }
+        if (it->m_sentTime <= lostSendTime || m_largestAcked >= pn + m_packetThreshold)
+        {
+            it->m_inFlight = false;
+            m_bytesInFlight -= it->m_size;
+            m_lost++;
+            NS_LOG_LOGIC("Packet number " << pn << " lost");
+            m_controller->OnPacketLost(now, pn, it->m_size);
+            m_lostTrace(pn, it->m_size);
+        }
+        else
+        {
+            m_lossTime = Min(m_lossTime, it->m_sentTime + lossDelay);
+        }
+    }
+}
+
+void
+LiteTransportSender::DiscardHead()
+{
+    while (!m_sentPackets.empty() && !m_sentPackets.front().m_inFlight)
+    {
+        m_sentPackets.pop_front();
+        m_firstPacketNumber++;
+    }
+}
+
+Time
+LiteTransportSender::GetPtoPeriod() const
+{
+    Time rttVar = m_hasRttSample ? m_rttVar : m_initialRtt / 2;
+    Time pto = GetSmoothedRtt() + Max(rttVar * 4, kGranularity) + m_maxAckDelay;
+    return pto * (int64_t(1) << std::min<uint32_t>(m_ptoCount, 16));
+}
+
+Time
+LiteTransportSender::GetLossDetectionDeadline() const
+{
+    if (m_lossTime != Time::Max())
+    {
+        return m_lossTime;
+    }
+    if (m_bytesInFlight > 0)
+    {
+        return m_lastSentTime + GetPtoPeriod();
+    }
+    return Time::Max();
+}
+
+void
+LiteTransportSender::SetLossDetectionTimer()
+{
+    Time deadline = GetLossDetectionDeadline();
+    if (deadline == Time::Max())
+    {
+        m_lossTimer.Cancel();
+        return;
+    }
+    // A timer expiring earlier re-arms itself, so that sending a datagram
+    // (which moves the deadline forward) does not reschedule the event
+    Time now = Simulator::Now();
+    if (m_lossTimer.IsRunning() && now + Simulator::GetDelayLeft(m_lossTimer) <= deadline)
+    {
+        return;
+    }
+    m_lossTimer.Cancel();
+    m_lossTimer = Simulator::Schedule(Max(deadline - now, Time(0)),
+                                      &LiteTransportSender::OnLossDetectionTimeout,
+                                      this);
+}
+
+void
+LiteTransportSender::OnLossDetectionTimeout()
+{
+    NS_LOG_FUNCTION(this);
+
+    Time now = Simulator::Now();
+    Time deadline = GetLossDetectionDeadline();
+    if (deadline == Time::Max())
+    {
+        return;
+    }
+    if (deadline > now)
+    {
+        m_lossTimer = Simulator::Schedule(deadline - now,
+                                          &LiteTransportSender::OnLossDetectionTimeout,
+                                          this);
+        return;
+    }
+
+    if (m_lossTime != Time::Max())
+    {
+        DetectLostPackets();
+        DiscardHead();
+        SetLossDetectionTimer();
+        return;
+    }
+
+    // Probe timeout: elicit an ACK, with data if there is still some to send
+    m_ptoCount++;
+    NS_LOG_LOGIC("Probe timeout, count " << m_ptoCount);
+    bool hasData = m_maxBytes == 0 || m_totalTx < m_maxBytes;
+    LiteTransportHeader header;
+    SendDatagram(hasData ? m_size : header.GetSerializedSize());
+    SetLossDetectionTimer();
+}
+
+} // namespace ns3
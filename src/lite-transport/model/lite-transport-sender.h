@@ -0,0 +1,231 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef LITE_TRANSPORT_SENDER_H
+#define LITE_TRANSPORT_SENDER_H
+
+#include "lite-rate-controller.h"
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+
+#include <deque>
+
+namespace ns3
+{
+
+class Socket;
+class LiteTransportHeader;
+
+/**
+ * \ingroup lite-transport
+ *
+ * \brief Sender side of the lite transport
+ *
+ * The sender transmits DATA datagrams over UDP, paced at the rate given by
+ * its LiteRateController. Each datagram has a new packet number, so an ACK
+ * identifies exactly which transmission has been received. There is no
+ * retransmission: each datagram is eventually reported to the rate
+ * controller either as acked or as lost.
+ *
+ * RTT estimation and loss detection follow RFC 9002: a datagram is lost
+ * when a datagram sent PacketThreshold packet numbers later has been acked,
+ * or when it is older than TimeThreshold times the RTT and a later datagram
+ * has been acked. If no ACK arrives for a probe timeout, a probe datagram
+ * is sent to elicit one.
+ */
+class LiteTransportSender : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LiteTransportSender();
+    ~LiteTransportSender() override;
+
+    /**
+     * \brief set the remote address and port
+     * \param ip remote IP address
+     * \param port remote port
+     */
+    void SetRemote(Address ip, uint16_t port);
+    /**
+     * \brief set the remote address
+     * \param addr remote address
+     */
+    void SetRemote(Address addr);
+
+    /**
+     * \brief Set the rate controller
+     * \param controller the rate controller
+     */
+    void SetRateController(Ptr<LiteRateController> controller);
+    /**
+     * \return the rate controller
+     */
+    Ptr<LiteRateController> GetRateController() const;
+
+    /**
+     * \return the total bytes sent
+     */
+    uint64_t GetTotalTx() const;
+    /**
+     * \return the number of datagrams sent
+     */
+    uint64_t GetSent() const;
+    /**
+     * \return the number of datagrams acked
+     */
+    uint64_t GetAcked() const;
+    /**
+     * \return the number of datagrams declared lost
+     */
+    uint64_t GetLost() const;
+    /**
+     * \return the smoothed RTT
+     */
+    Time GetSmoothedRtt() const;
+
+    /**
+     * TracedCallback signature for per-datagram events.
+     *
+     * \param [in] packetNumber The packet number.
+     * \param [in] bytes The datagram size.
+     */
+    typedef void (*PacketTracedCallback)(uint64_t packetNumber, uint32_t bytes);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// A datagram waiting for its ACK
+    struct SentPacket
+    {
+        Time m_sentTime;   //!< Transmission time
+        uint32_t m_size;   //!< Datagram size
+        bool m_inFlight;   //!< False once acked or lost
+    };
+
+    /**
+     * \brief Send a datagram and schedule the next one
+     */
+    void Send();
+
+    /**
+     * \brief Send a datagram
+     * \param size the datagram size
+     */
+    void SendDatagram(uint32_t size);
+
+    /**
+     * \brief Handle a packet reception.
+     * \param socket the socket the packet was received from
+     */
+    void HandleRead(Ptr<Socket> socket);
+
+    /**
+     * \brief Process the ranges of an ACK
+     * \param header the ACK header
+     */
+    void ProcessAck(const LiteTransportHeader& header);
+
+    /**
+     * \brief Update the RTT estimation
+     * \param latestRtt the new sample
+     * \param ackDelay the delay reported by the receiver
+     */
+    void UpdateRtt(Time latestRtt, Time ackDelay);
+
+    /**
+     * \brief Declare lost the datagrams that meet the loss thresholds
+     */
+    void DetectLostPackets();
+
+    /**
+     * \brief Remove the acked or lost datagrams from the head of the list
+     */
+    void DiscardHead();
+
+    /**
+     * \return the probe timeout, backed off by the number of probes sent
+     */
+    Time GetPtoPeriod() const;
+
+    /**
+     * \return the time at which the loss detection timer should expire,
+     * or Time::Max () if it should not run
+     */
+    Time GetLossDetectionDeadline() const;
+
+    /**
+     * \brief Arm the loss detection timer
+     */
+    void SetLossDetectionTimer();
+
+    /**
+     * \brief Called when the loss detection timer expires
+     */
+    void OnLossDetectionTimeout();
+
+    Address m_peerAddress;                  //!< Remote peer address
+    uint16_t m_peerPort;                    //!< Remote peer port
+    uint32_t m_size;                        //!< Size of the DATA datagrams
+    uint64_t m_maxBytes;                    //!< Limit of bytes to send (0: no limit)
+    DataRate m_initialRate;                 //!< Rate before the first controller decision
+    Ptr<LiteRateController> m_controller;   //!< Rate controller
+    Time m_initialRtt;                      //!< RTT before the first sample
+    uint32_t m_packetThreshold;             //!< Reordering threshold in packets
+    double m_timeThreshold;                 //!< Reordering threshold in RTTs
+    Time m_maxAckDelay;                     //!< Maximum ACK delay of the receiver
+    Ptr<Socket> m_socket;                   //!< Socket
+    EventId m_sendEvent;                    //!< Event to send the next datagram
+    EventId m_lossTimer;                    //!< Loss detection and probe timer
+    std::deque<SentPacket> m_sentPackets;   //!< Datagrams from the oldest in flight
+    uint64_t m_firstPacketNumber;           //!< Packet number of the head of m_sentPackets
+    uint64_t m_nextPacketNumber;            //!< Next packet number
+    uint64_t m_largestAcked;                //!< Largest acked packet number
+    bool m_hasRttSample;                    //!< True after the first RTT sample
+    uint64_t m_bytesInFlight;               //!< Bytes neither acked nor lost
+    Time m_lastSentTime;                    //!< Time of the last transmission
+    Time m_lossTime;                        //!< Time at which a datagram will be lost
+    uint32_t m_ptoCount;                    //!< Probes sent without an ACK
+    Time m_minRtt;                          //!< Minimum RTT
+    Time m_smoothedRtt;                     //!< Smoothed RTT
+    Time m_rttVar;                          //!< RTT variation
+    uint64_t m_totalTx;                     //!< Total bytes sent
+    uint64_t m_acked;                       //!< Datagrams acked
+    uint64_t m_lost;                        //!< Datagrams lost
+    TracedValue<DataRate> m_rate;           //!< Current sending rate
+    TracedValue<Time> m_latestRtt;          //!< Latest RTT sample
+    TracedCallback<uint64_t, uint32_t> m_txTrace;    //!< Datagram sent
+    TracedCallback<uint64_t, uint32_t> m_ackedTrace; //!< Datagram acked
+    TracedCallback<uint64_t, uint32_t> m_lostTrace;  //!< Datagram lost
+};
+
+} // namespace ns3
+
+#endif /* LITE_TRANSPORT_SENDER_H */
@@ -0,0 +1,237 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/error-model.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/lite-transport-header.h"
+#include "ns3/lite-transport-helper.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <map>
+
+using namespace ns3;
+
+/**
+ * \ingroup lite-transport
+ * \defgroup lite-transport-test lite transport tests
+ */
+
+/**
+ * \ingroup lite-transport-test
+ * \ingroup tests
+ *
+ * \brief Serialization of the lite transport header.
+ */
+class LiteTransportHeaderTestCase : public TestCase
+{
+  public:
+    LiteTransportHeaderTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LiteTransportHeaderTestCase::LiteTransportHeaderTestCase()
+    : TestCase("Check the serialization of the DATA and ACK headers")
+{
+}
+
+void
+LiteTransportHeaderTestCase::DoRun()
+{
+    LiteTransportHeader data;
+    data.SetPacketNumber(0x123456789aULL);
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddHeader(data);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 109, "Wrong DATA header size");
+
+    LiteTransportHeader dataCopy;
+    p->RemoveHeader(dataCopy);
+    NS_TEST_ASSERT_MSG_EQ(dataCopy.GetType(), LiteTransportHeader::DATA, "Wrong type");
+    NS_TEST_ASSERT_MSG_EQ(dataCopy.GetPacketNumber(), 0x123456789aULL, "Wrong packet number");
+
+    LiteTransportHeader ack;
+    ack.SetType(LiteTransportHeader::ACK);
+    ack.SetAckDelay(MicroSeconds(1500));
+    ack.AddAckRange(20, 25);
+    ack.AddAckRange(17, 17);
+    ack.AddAckRange(0, 10);
+    p = Create<Packet>();
+    p->AddHeader(ack);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), ack.GetSerializedSize(), "Wrong ACK header size");
+
+    LiteTransportHeader ackCopy;
+    p->RemoveHeader(ackCopy);
+    NS_TEST_ASSERT_MSG_EQ(ackCopy.GetType(), LiteTransportHeader::ACK, "Wrong type");
+    NS_TEST_ASSERT_MSG_EQ(ackCopy.GetAckDelay(), MicroSeconds(1500), "Wrong ACK delay");
+    NS_TEST_ASSERT_MSG_EQ(ackCopy.GetLargestAcked(), 25, "Wrong largest acked");
+    NS_TEST_ASSERT_MSG_EQ(ackCopy.GetAckRanges().size(), 3, "Wrong number of ranges");
+    NS_TEST_ASSERT_MSG_EQ((ackCopy.GetAckRanges() == ack.GetAckRanges()), true, "Wrong ranges");
+}
+
+/**
+ * \ingroup lite-transport-test
+ * \ingroup tests
+ *
+ * \brief Transfer over a lossy link.
+ *
+ * Each datagram must be reported exactly once, as acked if the receiver got
+ * it and as lost otherwise.
+ */
+class LiteTransportLossTestCase : public TestCase
+{
+  public:
+    LiteTransportLossTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Record an acked datagram
+     * \param packetNumber the packet number
+     * \param bytes the datagram size
+     */
+    void Acked(uint64_t packetNumber, uint32_t bytes);
+    /**
+     * \brief Record a lost datagram
+     * \param packetNumber the packet number
+     * \param bytes the datagram size
+     */
+    void Lost(uint64_t packetNumber, uint32_t bytes);
+
+    std::map<uint64_t, bool> m_outcomes; //!< Outcome of each packet number
+    uint32_t m_duplicates;               //!< Datagrams reported more than once
+};
+
+LiteTransportLossTestCase::LiteTransportLossTestCase()
+    : TestCase("Check that each datagram is reported either acked or lost"),
+      m_duplicates(0)
+{
+}
+
+void
+LiteTransportLossTestCase::Acked(uint64_t packetNumber, uint32_t bytes)
+{
+    if (!m_outcomes.emplace(packetNumber, true).second)
+    {
+        m_duplicates++;
+    }
+}
+
+void
+LiteTransportLossTestCase::Lost(uint64_t packetNumber, uint32_t bytes)
+{
+    if (!m_outcomes.emplace(packetNumber, false).second)
+    {
+        m_duplicates++;
+    }
+}
+
+void
+LiteTransportLossTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    SimpleNetDeviceHelper link;
+    link.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    link.SetChannelAttribute("Delay", StringValue("10ms"));
+    link.SetNetDevicePointToPointMode(true);
+    NetDeviceContainer devices = link.Install(nodes);
+
+    // Drop DATA datagrams only, so that losses are known at the receiver
+    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    em->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    em->SetRate(0.05);
+    em->AssignStreams(1);
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    uint16_t port = 4000;
+    LiteTransportReceiverHelper receiverHelper(port);
+    ApplicationContainer receiverApps = receiverHelper.Install(nodes.Get(1));
+    receiverApps.Start(Seconds(0));
+    receiverApps.Stop(Seconds(10));
+
+    LiteTransportSenderHelper senderHelper(interfaces.GetAddress(1), port);
+    senderHelper.SetAttribute("PacketSize", UintegerValue(1000));
+    senderHelper.SetAttribute("MaxBytes", UintegerValue(1000000));
+    senderHelper.SetRateController("ns3::LiteConstantRateController",
+                                   "DataRate",
+                                   StringValue("5Mbps"));
+    ApplicationContainer senderApps = senderHelper.Install(nodes.Get(0));
+    senderApps.Start(Seconds(1));
+    senderApps.Stop(Seconds(10));
+
+    Ptr<LiteTransportSender> sender = DynamicCast<LiteTransportSender>(senderApps.Get(0));
+    Ptr<LiteTransportReceiver> receiver = DynamicCast<LiteTransportReceiver>(receiverApps.Get(0));
+    sender->TraceConnectWithoutContext("Acked",
+                                       MakeCallback(&LiteTransportLossTestCase::Acked, this));
+    sender->TraceConnectWithoutContext("Lost",
+                                       MakeCallback(&LiteTransportLossTestCase::Lost, this));
+
+    Simulator::Stop(Seconds(11));
+    Simulator::Run();
+
+    uint64_t received = receiver->GetReceived();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(sender->GetTotalTx(), 1000000, "Not all the data has been sent");
+    NS_TEST_ASSERT_MSG_LT(received, sender->GetSent(), "No datagram has been dropped");
+    NS_TEST_ASSERT_MSG_EQ(m_duplicates, 0, "Datagrams reported more than once");
+    NS_TEST_ASSERT_MSG_EQ(m_outcomes.size(), sender->GetSent(), "Datagrams not reported");
+    NS_TEST_ASSERT_MSG_EQ(sender->GetAcked(), received, "Wrong number of acked datagrams");
+    NS_TEST_ASSERT_MSG_EQ(sender->GetLost(),
+                          sender->GetSent() - received,
+                          "Wrong number of lost datagrams");
+    NS_TEST_ASSERT_MSG_EQ_TOL(sender->GetSmoothedRtt(),
+                              MilliSeconds(22),
+                              MilliSeconds(10),
+                              "Wrong smoothed RTT");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lite-transport-test
+ * \ingroup tests
+ *
+ * \brief Lite transport TestSuite
+ */
+class LiteTransportTestSuite : public TestSuite
+{
+  public:
+    LiteTransportTestSuite();
+};
+
+LiteTransportTestSuite::LiteTransportTestSuite()
+    : TestSuite("lite-transport", UNIT)
+{
+    AddTestCase(new LiteTransportHeaderTestCase, TestCase::QUICK);
+    AddTestCase(new LiteTransportLossTestCase, TestCase::QUICK);
+}
+
+static LiteTransportTestSuite g_liteTransportTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,54 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MTP_INTERFACE_H
+#define MTP_INTERFACE_H
+
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MtpInterface declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Selects the multithreaded simulator.
+ *
+ * The nodes must be assigned to logical processes through their system id,
+ * e.g. with NodeContainer::Create (n, systemId), before Simulator::Run ().
+ */
+class MtpInterface
+{
+  public:
+    /**
+     * Use MultithreadedSimulatorImpl as the simulator implementation.
+     *
+     * This must be called before the simulator is first used.
+     *
+     * \param [in] maxThreads The maximum number of threads, or 0 to use
+     *             as many as the hardware threads.
+     */
+    static void Enable(uint32_t maxThreads = 0);
+};
+
+} // namespace ns3
+
+#endif /* MTP_INTERFACE_H */
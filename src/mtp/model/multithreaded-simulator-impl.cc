@@ -0,0 +1,691 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::LogicalProcess* MultithreadedSimulatorImpl::m_current =
+    nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads running the logical processes "
+                          "(0: the number of hardware threads)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_partitioned(false),
+      m_lookahead(Time::Max()),
+      m_stop(false),
+      m_parallel(false),
+      m_windowStart(0),
+      m_windowEnd(0),
+      m_window(0),
+      m_busyWorkers(0),
+      m_exit(false),
+      m_nextLp(0)
+{
+    NS_LOG_FUNCTION(this);
+    auto global = std::make_unique<LogicalProcess>();
+    global->m_index = 0;
+    global->m_currentTs = 0;
+    global->m_currentContext = Simulator::NO_CONTEXT;
+    global->m_currentUid = EventId::UID::INVALID;
+    global->m_uid = EventId::UID::VALID;
+    global->m_eventCount = 0;
+    global->m_packetUid = 0;
+    global->m_streamIndex = 0;
+    m_lps.push_back(std::move(global));
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ReceiveEvents();
+    for (auto& lp : m_lps)
+    {
+        while (lp->m_events && !lp->m_events->IsEmpty())
+        {
+            Scheduler::Event next = lp->m_events->RemoveNext();
+            next.impl->Unref();
+        }
+        lp->m_events = nullptr;
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(!m_parallel, "Cannot change the scheduler during a window");
+    m_schedulerFactory = schedulerFactory;
+    for (auto& lp : m_lps)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (lp->m_events)
+        {
+            while (!lp->m_events->IsEmpty())
+            {
+                scheduler->Insert(lp->m_events->RemoveNext());
+            }
+        }
+        lp->m_events = scheduler;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetLogicalProcessCount() const
+{
+    return m_lps.size();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return m_lookahead;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::GetCurrent() const
+{
+    return m_current != nullptr ? *m_current : *m_lps[0];
+}
+
+MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::GetLogicalProcess(uint32_t context) const
+{
+    if (context < m_nodeLp.size())
+    {
+        return *m_lps[m_nodeLp[context]];
+    }
+    return *m_lps[0];
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert(LogicalProcess& lp,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = lp.m_uid;
+    lp.m_uid++;
+    lp.m_events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    LogicalProcess& global = *m_lps[0];
+
+    // One logical process per system id, in increasing system id order
+    std::map<uint32_t, uint32_t> systemLp;
+    for (NodeList::Iterator it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        systemLp.emplace((*it)->GetSystemId(), 0);
+    }
+    for (auto& entry : systemLp)
+    {
+        entry.second = m_lps.size();
+        auto lp = std::make_unique<LogicalProcess>();
+        lp->m_index = m_lps.size();
+        lp->m_events = m_schedulerFactory.Create<Scheduler>();
+        lp->m_currentTs = global.m_currentTs;
+        lp->m_currentContext = Simulator::NO_CONTEXT;
+        lp->m_currentUid = global.m_currentUid;
+        // Keep the uids unique with the events moved from the global list
+        lp->m_uid = global.m_uid;
+        lp->m_eventCount = 0;
+        // Each logical process has its own range of packet uids and streams
+        lp->m_packetUid = static_cast<uint64_t>(lp->m_index) << 32;
+        lp->m_streamIndex = static_cast<uint64_t>(lp->m_index) << 48;
+        m_lps.push_back(std::move(lp));
+    }
+    m_nodeLp.resize(NodeList::GetNNodes());
+    for (NodeList::Iterator it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        m_nodeLp[(*it)->GetId()] = systemLp[(*it)->GetSystemId()];
+    }
+    NS_LOG_INFO(m_nodeLp.size() << " nodes in " << systemLp.size() << " logical processes");
+
+    // Move the events scheduled so far to the logical process of their node
+    Ptr<Scheduler> events = m_schedulerFactory.Create<Scheduler>();
+    while (!global.m_events->IsEmpty())
+    {
+        Scheduler::Event ev = global.m_events->RemoveNext();
+        LogicalProcess& lp = GetLogicalProcess(ev.key.m_context);
+        (lp.m_index == 0 ? events : lp.m_events)->Insert(ev);
+    }
+    global.m_events = events;
+    m_partitioned = true;
+}
+
+void
+MultithreadedSimulatorImpl::CalculateLookahead()
+{
+    NS_LOG_FUNCTION(this);
+    m_lookahead = Time::Max();
+    for (ChannelList::Iterator it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+    {
+        Ptr<Channel> channel = *it;
+        bool crossing = false;
+        int64_t first = -1;
+        for (std::size_t i = 0; i < channel->GetNDevices(); i++)
+        {
+            Ptr<Node> node = channel->GetDevice(i)->GetNode();
+            if (!node)
+            {
+                continue;
+            }
+            int64_t lp = GetLogicalProcess(node->GetId()).m_index;
+            crossing |= (first >= 0 && lp != first);
+            first = lp;
+        }
+        if (!crossing)
+        {
+            continue;
+        }
+        TimeValue delay;
+        if (!channel->GetAttributeFailSafe("Delay", delay))
+        {
+            NS_FATAL_ERROR("Channel " << channel->GetId() << " (" << channel->GetInstanceTypeId()
+                                      << ") connects logical processes but has no Delay");
+        }
+        NS_ABORT_MSG_IF(!delay.Get().IsStrictlyPositive(),
+                        "Channel " << channel->GetId()
+                                   << " connects logical processes with a zero delay");
+        m_lookahead = Min(m_lookahead, delay.Get());
+    }
+    NS_LOG_INFO("lookahead " << m_lookahead.As(Time::US));
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveEvents()
+{
+    for (auto& lp : m_lps)
+    {
+        std::vector<InboxEvent> inbox;
+        {
+            std::unique_lock lock{lp->m_inboxMutex};
+            lp->m_inbox.swap(inbox);
+        }
+        // Order the events independently of the thread scheduling
+        std::sort(inbox.begin(), inbox.end(), [](const InboxEvent& a, const InboxEvent& b) {
+            return std::tie(a.m_ts, a.m_sender, a.m_uid) < std::tie(b.m_ts, b.m_sender, b.m_uid);
+        });
+        for (const auto& ev : inbox)
+        {
+            Insert(*lp, ev.m_ts, ev.m_context, ev.m_impl);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessEvents(LogicalProcess& lp, uint64_t end)
+{
+    bool global = lp.m_index == 0;
+    m_current = global ? nullptr : &lp;
+    if (!global)
+    {
+        Packet::SetUidCounter(&lp.m_packetUid);
+        RngSeedManager::SetStreamIndexCounter(&lp.m_streamIndex);
+    }
+    // A Stop() requested by a node event is applied at the next window
+    // barrier, so that every logical process finishes the same window
+    // whatever the thread scheduling; the global events run alone, and
+    // stop at once as in the default simulator.
+    while (!lp.m_events->IsEmpty() && !(global && m_stop.load(std::memory_order_relaxed)))
+    {
+        Scheduler::Event next = lp.m_events->PeekNext();
+        if (next.key.m_ts >= end)
+        {
+            break;
+        }
+        lp.m_events->RemoveNext();
+
+        NS_ASSERT(next.key.m_ts >= lp.m_currentTs);
+        lp.m_currentTs = next.key.m_ts;
+        lp.m_currentContext = next.key.m_context;
+        lp.m_currentUid = next.key.m_uid;
+        lp.m_eventCount.store(lp.m_eventCount.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+        next.impl->Invoke();
+        next.impl->Unref();
+    }
+    if (!global)
+    {
+        Packet::SetUidCounter(nullptr);
+        RngSeedManager::SetStreamIndexCounter(nullptr);
+    }
+    m_current = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow()
+{
+    uint32_t i;
+    while ((i = m_nextLp.fetch_add(1, std::memory_order_relaxed)) < m_lps.size())
+    {
+        ProcessEvents(*m_lps[i], m_windowEnd);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop()
+{
+    uint64_t window = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_startWindow.wait(lock, [this, window]() { return m_exit || m_window != window; });
+            if (m_exit)
+            {
+                return;
+            }
+            window = m_window;
+        }
+        ProcessWindow();
+        {
+            std::unique_lock lock{m_poolMutex};
+            if (--m_busyWorkers == 0)
+            {
+                m_endWindow.notify_one();
+            }
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    CalculateLookahead();
+    m_stop = false;
+
+    uint32_t nThreads = m_maxThreads;
+    if (nThreads == 0)
+    {
+        nThreads = std::thread::hardware_concurrency();
+    }
+    nThreads = std::max<uint32_t>(std::min<uint32_t>(nThreads, m_lps.size() - 1), 1);
+    NS_LOG_INFO("running " << m_lps.size() - 1 << " logical processes on " << nThreads
+                           << " threads");
+    m_exit = false;
+    m_window = 0;
+    for (uint32_t i = 1; i < nThreads; i++)
+    {
+        m_workers.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop, this);
+    }
+
+    LogicalProcess& global = *m_lps[0];
+    uint64_t lookahead = m_lookahead.GetTimeStep();
+    while (!m_stop)
+    {
+        ReceiveEvents();
+        uint64_t next = UINT64_MAX;
+        for (auto& lp : m_lps)
+        {
+            if (!lp->m_events->IsEmpty())
+            {
+                next = std::min(next, lp->m_events->PeekNext().key.m_ts);
+            }
+        }
+        if (next == UINT64_MAX)
+        {
+            break;
+        }
+
+        // The global events run alone, before the node events at the same time
+        uint64_t globalNext =
+            global.m_events->IsEmpty() ? UINT64_MAX : global.m_events->PeekNext().key.m_ts;
+        if (globalNext == next)
+        {
+            ProcessEvents(global, next + 1);
+            continue;
+        }
+
+        m_windowStart = next;
+        m_windowEnd = next > UINT64_MAX - lookahead ? UINT64_MAX : next + lookahead;
+        m_windowEnd = std::min(m_windowEnd, globalNext);
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_parallel = true;
+            m_nextLp = 1;
+            m_busyWorkers = m_workers.size();
+            m_window++;
+        }
+        m_startWindow.notify_all();
+        ProcessWindow();
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_endWindow.wait(lock, [this]() { return m_busyWorkers == 0; });
+            m_parallel = false;
+        }
+    }
+
+    {
+        std::unique_lock lock{m_poolMutex};
+        m_exit = true;
+    }
+    m_startWindow.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    ReceiveEvents();
+
+    // Simulator::Now () after the run is the time of the latest event
+    for (auto& lp : m_lps)
+    {
+        global.m_currentTs = std::max(global.m_currentTs, lp->m_currentTs);
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (auto& lp : m_lps)
+    {
+        if (!lp->m_events->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    LogicalProcess& lp = GetCurrent();
+    uint64_t ts = lp.m_currentTs + delay.GetTimeStep();
+    uint32_t uid = Insert(lp, ts, lp.m_currentContext, event);
+    return EventId(event, ts, lp.m_currentContext, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(),
+                  "MultithreadedSimulatorImpl::ScheduleWithContext(): Negative delay");
+    LogicalProcess& sender = GetCurrent();
+    uint64_t ts = sender.m_currentTs + delay.GetTimeStep();
+    LogicalProcess& receiver = GetLogicalProcess(context);
+    if (&receiver == &sender || !m_parallel)
+    {
+        Insert(receiver, ts, context, event);
+        return;
+    }
+
+    NS_ABORT_MSG_IF(ts < m_windowEnd,
+                    "Event for context " << context << " at " << TimeStep(ts)
+                                         << " is before the end of the window, at "
+                                         << TimeStep(m_windowEnd)
+                                         << ": lookahead violated");
+    InboxEvent ev;
+    ev.m_ts = ts;
+    ev.m_context = context;
+    ev.m_sender = sender.m_index;
+    ev.m_uid = sender.m_uid++;
+    ev.m_impl = event;
+    std::unique_lock lock{receiver.m_inboxMutex};
+    receiver.m_inbox.push_back(ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(!m_parallel, "Simulator::ScheduleDestroy called during a window");
+    EventId id(Ptr<EventImpl>(event, false), GetCurrent().m_currentTs, 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrent().m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - GetCurrent().m_currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (DestroyEvents::iterator i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    LogicalProcess& lp = GetLogicalProcess(id.GetContext());
+    if (m_parallel && &lp != &GetCurrent())
+    {
+        // The event list of another logical process cannot be changed
+        id.PeekEventImpl()->Cancel();
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    lp.m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (DestroyEvents::const_iterator i = m_destroyEvents.begin(); i != m_destroyEvents.end();
+             i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+    {
+        return true;
+    }
+    const LogicalProcess& lp = GetLogicalProcess(id.GetContext());
+    if (m_parallel && &lp != &GetCurrent())
+    {
+        // All the events before the window have been executed
+        return id.GetTs() < m_windowStart;
+    }
+    return id.GetTs() < lp.m_currentTs ||
+           (id.GetTs() == lp.m_currentTs && id.GetUid() <= lp.m_currentUid);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrent().m_currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (auto& lp : m_lps)
+    {
+        count += lp->m_eventCount.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,230 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \defgroup mtp Multithreaded Parallel Simulation
+ *
+ * Parallel simulation on the threads of a single process.
+ */
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Conservative parallel simulator running on a pool of threads.
+ *
+ * The nodes are partitioned into logical processes by system id (see
+ * Node::GetSystemId()), and each logical process has its own event list.
+ * Events without a node context (e.g., scheduled with Simulator::Schedule
+ * before the simulation starts) belong to a global logical process, which
+ * is run alone.
+ *
+ * The simulation advances in windows. The lookahead is the smallest delay
+ * of the channels which connect nodes of different logical processes; the
+ * events of a window, from the earliest pending event to the lookahead
+ * later, cannot depend on one another across logical processes, so each
+ * logical process runs its events of the window on one of the threads.
+ * Events scheduled for a node of another logical process are queued in the
+ * inbox of that logical process, and merged into its event list, in a
+ * deterministic order, at the end of the window.
+ *
+ * Objects, including packets, are passed between threads without
+ * serialization. This relies on the sender not touching an object once
+ * the receiver can use it, which holds for the packets sent over channels,
+ * since the receiver gets them at least the channel delay later.
+ * Trace sinks connected to nodes of several logical processes must be
+ * thread-safe.
+ *
+ * Each channel between logical processes must have a strictly positive
+ * "Delay" attribute. Nodes created after the first call to Run() are
+ * handled by the global logical process.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    void Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * \returns The number of logical processes, including the global one.
+     */
+    uint32_t GetLogicalProcessCount() const;
+
+    /**
+     * \returns The lookahead used by the last call to Run().
+     */
+    Time GetLookahead() const;
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent to another logical process. */
+    struct InboxEvent
+    {
+        uint64_t m_ts;      //!< Event time stamp
+        uint32_t m_context; //!< Event context
+        uint32_t m_sender;  //!< Index of the sending logical process
+        uint32_t m_uid;     //!< Event uid in the sending logical process
+        EventImpl* m_impl;  //!< The event
+    };
+
+    /** A logical process: a set of nodes and their events. */
+    struct LogicalProcess
+    {
+        uint32_t m_index;                   //!< Index of this logical process
+        Ptr<Scheduler> m_events;            //!< The event list
+        uint64_t m_currentTs;               //!< Time stamp of the current event
+        uint32_t m_currentContext;          //!< Context of the current event
+        uint32_t m_currentUid;              //!< Uid of the current event
+        uint32_t m_uid;                     //!< Next event uid
+        std::atomic<uint64_t> m_eventCount; //!< Number of executed events
+        uint64_t m_packetUid;               //!< Next packet uid
+        uint64_t m_streamIndex;             //!< Next automatically assigned stream index
+        std::mutex m_inboxMutex;            //!< Protects m_inbox
+        std::vector<InboxEvent> m_inbox;    //!< Events sent by other logical processes
+    };
+
+    /**
+     * \returns The logical process of the calling thread.
+     */
+    LogicalProcess& GetCurrent() const;
+
+    /**
+     * Get the logical process which runs the events of a context.
+     *
+     * \param [in] context The context (node id).
+     * \returns The logical process.
+     */
+    LogicalProcess& GetLogicalProcess(uint32_t context) const;
+
+    /**
+     * Insert an event in the event list of a logical process.
+     *
+     * \param [in] lp The logical process.
+     * \param [in] ts The time stamp.
+     * \param [in] context The context.
+     * \param [in] event The event.
+     * \returns The event uid.
+     */
+    uint32_t Insert(LogicalProcess& lp, uint64_t ts, uint32_t context, EventImpl* event);
+
+    /** Create the logical processes from the system ids of the nodes. */
+    void Partition();
+
+    /** Compute the lookahead from the channels between logical processes. */
+    void CalculateLookahead();
+
+    /** Merge the inboxes into the event lists. */
+    void ReceiveEvents();
+
+    /**
+     * Execute the events of a logical process before a time stamp.
+     *
+     * \param [in] lp The logical process.
+     * \param [in] end The end of the window (excluded).
+     */
+    void ProcessEvents(LogicalProcess& lp, uint64_t end);
+
+    /** Process the logical processes of the current window, until none is left. */
+    void ProcessWindow();
+
+    /** Main loop of the worker threads. */
+    void WorkerLoop();
+
+    /** Type of the list of events to run at the end of the simulation. */
+    typedef std::list<EventId> DestroyEvents;
+
+    DestroyEvents m_destroyEvents;                      //!< Events to run at the end
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps; //!< Logical processes, global first
+    std::vector<uint32_t> m_nodeLp;                     //!< Logical process of each node
+    bool m_partitioned;                                 //!< True once Partition() ran
+    ObjectFactory m_schedulerFactory;                   //!< Scheduler of the logical processes
+    uint32_t m_maxThreads;                              //!< Maximum number of threads
+    Time m_lookahead;                                   //!< Lookahead of the last run
+    std::atomic<bool> m_stop;                           //!< Stop requested
+    bool m_parallel;                                    //!< True during a window
+    uint64_t m_windowStart;                             //!< Start of the current window
+    uint64_t m_windowEnd;                               //!< End of the current window
+
+    std::vector<std::thread> m_workers;    //!< Worker threads
+    std::mutex m_poolMutex;                //!< Protects the pool state
+    std::condition_variable m_startWindow; //!< Signals a new window or the exit
+    std::condition_variable m_endWindow;   //!< Signals the end of the window
+    uint64_t m_window;                     //!< Window counter
+    uint32_t m_busyWorkers;                //!< Workers still in the window
+    bool m_exit;                           //!< Workers must exit
+    std::atomic<uint32_t> m_nextLp;        //!< Next logical process to run in the window
+
+    /** Logical process run by the calling thread, or nullptr for the global one. */
+    static thread_local LogicalProcess* m_current;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,328 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * Multithreaded simulator test suite.
+ */
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-tests Multithreaded simulator tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief Compare a ring of nodes run by the multithreaded simulator with
+ * the default simulator.
+ *
+ * Each of the four nodes is in its own logical process, and sends packets
+ * to its neighbors, which forward them around the ring a few times. The
+ * packets received by each node must be the same, at the same times, with
+ * both simulators. The receptions are compared once sorted, since the
+ * simulators may order simultaneous events differently. The ring is then
+ * stopped by a node event, and the receptions, with the packet uids, must
+ * be the same with one thread and with \c maxThreads threads.
+ */
+class MtpRingTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] maxThreads The maximum number of threads.
+     */
+    MtpRingTestCase(uint32_t maxThreads);
+
+  private:
+    void DoRun() override;
+
+    /** A packet reception: time, device, size or packet uid. */
+    typedef std::tuple<int64_t, uint32_t, uint64_t> Reception;
+
+    /**
+     * Build and run the ring.
+     *
+     * \param [in] impl The simulator implementation.
+     * \param [in] stop Whether node 2 stops the simulation at 3.05 ms.
+     * \returns The receptions of each node.
+     */
+    std::vector<std::vector<Reception>> RunRing(Ptr<SimulatorImpl> impl, bool stop = false);
+
+    /**
+     * Send a packet on both devices of a node, and schedule the next one.
+     *
+     * \param [in] node The node.
+     * \param [in] n The number of packets left to send.
+     */
+    void Send(Ptr<Node> node, uint32_t n);
+
+    /**
+     * Record a reception and forward small packets to the next node.
+     *
+     * \param [in] device The receiving device.
+     * \param [in] packet The packet.
+     * \param [in] protocol The protocol number.
+     * \param [in] from The sender address.
+     * \returns true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /** Record the time and context of a global event. */
+    void Global();
+
+    /** Stop the simulation. */
+    void Stop();
+
+    /**
+     * Run the ring with the multithreaded simulator, stopped by a node.
+     *
+     * \param [in] maxThreads The maximum number of threads.
+     * \returns The receptions of each node, with the packet uids, and the
+     *          number of executed events.
+     */
+    std::pair<std::vector<std::vector<Reception>>, uint64_t> RunStopped(uint32_t maxThreads);
+
+    uint32_t m_maxThreads;                              //!< Maximum number of threads
+    bool m_recordUids;                                  //!< Record the uids instead of the sizes
+    std::vector<std::vector<Reception>> m_receptions;   //!< Receptions of each node
+    std::vector<std::pair<int64_t, uint32_t>> m_global; //!< Time and context of global events
+};
+
+MtpRingTestCase::MtpRingTestCase(uint32_t maxThreads)
+    : TestCase("Check a ring of nodes against the default simulator, with " +
+               std::to_string(maxThreads) + " threads"),
+      m_maxThreads(maxThreads),
+      m_recordUids(false)
+{
+}
+
+void
+MtpRingTestCase::Send(Ptr<Node> node, uint32_t n)
+{
+    for (uint32_t i = 0; i < node->GetNDevices(); i++)
+    {
+        Ptr<NetDevice> device = node->GetDevice(i);
+        device->Send(Create<Packet>(100 + node->GetId()), device->GetBroadcast(), 0x800);
+    }
+    if (n > 1)
+    {
+        Simulator::Schedule(MicroSeconds(250 + 10 * node->GetId()),
+                            &MtpRingTestCase::Send,
+                            this,
+                            node,
+                            n - 1);
+    }
+}
+
+bool
+MtpRingTestCase::Receive(Ptr<NetDevice> device,
+                         Ptr<const Packet> packet,
+                         uint16_t protocol,
+                         const Address& from)
+{
+    Ptr<Node> node = device->GetNode();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), node->GetId(), "Wrong context");
+    m_receptions[node->GetId()].emplace_back(Simulator::Now().GetTimeStep(),
+                                             device->GetIfIndex(),
+                                             m_recordUids ? packet->GetUid() : packet->GetSize());
+    if (packet->GetSize() < 160)
+    {
+        // Forward a larger copy on the other device
+        Ptr<Packet> copy = packet->Copy();
+        copy->AddPaddingAtEnd(20);
+        Ptr<NetDevice> other = node->GetDevice(1 - device->GetIfIndex());
+        other->Send(copy, other->GetBroadcast(), protocol);
+    }
+    return true;
+}
+
+void
+MtpRingTestCase::Global()
+{
+    m_global.emplace_back(Simulator::Now().GetTimeStep(), Simulator::GetContext());
+}
+
+void
+MtpRingTestCase::Stop()
+{
+    Simulator::Stop();
+}
+
+std::vector<std::vector<MtpRingTestCase::Reception>>
+MtpRingTestCase::RunRing(Ptr<SimulatorImpl> impl, bool stop)
+{
+    Simulator::Destroy();
+    Simulator::SetImplementation(impl);
+    m_receptions.assign(4, {});
+    m_global.clear();
+
+    NodeContainer nodes;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        nodes.Create(1, i);
+    }
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
+    helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("99Mbps")));
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        NetDeviceContainer devices =
+            helper.Install(NodeContainer(nodes.Get(i), nodes.Get((i + 1) % 4)));
+        for (uint32_t j = 0; j < devices.GetN(); j++)
+        {
+            devices.Get(j)->SetReceiveCallback(MakeCallback(&MtpRingTestCase::Receive, this));
+        }
+    }
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(100 * i),
+                                       &MtpRingTestCase::Send,
+                                       this,
+                                       nodes.Get(i),
+                                       40);
+    }
+    Simulator::Schedule(MilliSeconds(5), &MtpRingTestCase::Global, this);
+    Simulator::Schedule(MicroSeconds(7500), &MtpRingTestCase::Global, this);
+    if (stop)
+    {
+        Simulator::ScheduleWithContext(2, MicroSeconds(3050), &MtpRingTestCase::Stop, this);
+    }
+
+    Simulator::Run();
+    if (stop)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_global.size(), 0, "The global events should not run");
+    }
+    else if (m_global.size() != 2)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_global.size(), 2, "Missing global events");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_global[0].first, MilliSeconds(5).GetTimeStep(), "Wrong time");
+        NS_TEST_EXPECT_MSG_EQ(m_global[1].second, Simulator::NO_CONTEXT, "Wrong context");
+    }
+    return m_receptions;
+}
+
+std::pair<std::vector<std::vector<MtpRingTestCase::Reception>>, uint64_t>
+MtpRingTestCase::RunStopped(uint32_t maxThreads)
+{
+    m_recordUids = true;
+    std::vector<std::vector<Reception>> receptions =
+        RunRing(CreateObjectWithAttributes<MultithreadedSimulatorImpl>("MaxThreads",
+                                                                       UintegerValue(maxThreads)),
+                true);
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    m_recordUids = false;
+    for (auto& node : receptions)
+    {
+        std::sort(node.begin(), node.end());
+    }
+    return {receptions, events};
+}
+
+void
+MtpRingTestCase::DoRun()
+{
+    std::vector<std::vector<Reception>> expected = RunRing(CreateObject<DefaultSimulatorImpl>());
+    uint64_t expectedEvents = Simulator::GetEventCount();
+    Time expectedEnd = Simulator::Now();
+    Simulator::Destroy();
+
+    Ptr<MultithreadedSimulatorImpl> mtp =
+        CreateObjectWithAttributes<MultithreadedSimulatorImpl>("MaxThreads",
+                                                               UintegerValue(m_maxThreads));
+    std::vector<std::vector<Reception>> receptions = RunRing(mtp);
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetLogicalProcessCount(), 5, "One logical process per node");
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetLookahead(), MilliSeconds(1), "Lookahead is the link delay");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), expectedEvents, "Different event count");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), expectedEnd, "Different end time");
+    Simulator::Destroy();
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        std::sort(expected[i].begin(), expected[i].end());
+        std::sort(receptions[i].begin(), receptions[i].end());
+        NS_TEST_EXPECT_MSG_GT(expected[i].size(), 0, "No packet received by node " << i);
+        NS_TEST_EXPECT_MSG_EQ(receptions[i].size(),
+                              expected[i].size(),
+                              "Different number of receptions at node " << i);
+        for (std::size_t j = 0; j < std::min(receptions[i].size(), expected[i].size()); j++)
+        {
+            NS_TEST_EXPECT_MSG_EQ((receptions[i][j] == expected[i][j]),
+                                  true,
+                                  "Different reception " << j << " at node " << i);
+        }
+    }
+
+    // A stop requested by a node, and the packet uids, do not depend on the
+    // number of threads
+    auto expectedStopped = RunStopped(1);
+    auto stopped = RunStopped(m_maxThreads);
+    NS_TEST_EXPECT_MSG_LT(expectedStopped.second, expectedEvents, "The simulation should stop");
+    NS_TEST_EXPECT_MSG_EQ(stopped.second, expectedStopped.second, "Different event count");
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((stopped.first[i] == expectedStopped.first[i]),
+                              true,
+                              "Different receptions or packet uids at node " << i);
+    }
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief Multithreaded simulator TestSuite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite();
+};
+
+MtpTestSuite::MtpTestSuite()
+    : TestSuite("mtp", UNIT)
+{
+    AddTestCase(new MtpRingTestCase(1), TestCase::QUICK);
+    AddTestCase(new MtpRingTestCase(4), TestCase::QUICK);
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
@@ -54,7 +54,11 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
+#endif
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -263,8 +267,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -286,8 +289,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -312,7 +314,12 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // The dirty area of shared data may be extended by another thread
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -330,8 +337,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         struct Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -358,7 +364,12 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // The dirty area of shared data may be extended by another thread
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -376,8 +387,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         struct Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -404,15 +414,19 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
-        o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+    if ((m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+        o.m_start == o.m_zeroAreaStart && o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
         /**
          * This is an optimization which kicks in when
          * we attempt to aggregate two buffers which contain
          * adjacent zero areas.
          */
+        if (m_data->m_count != 1 || m_end != m_data->m_dirtyEnd)
+        {
+            // the data is shared (e.g., this buffer is a fragment)
+            DetachData();
+        }
         if (m_zeroAreaStart == m_zeroAreaEnd)
         {
             m_zeroAreaStart = m_end;
@@ -432,7 +446,24 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
+    /* The zero areas cannot be merged: keep the larger one, and write
+     * the other one as real zero bytes.
+     */
+    if (m_data == o.m_data)
+    {
+        // o is, e.g., a fragment of this buffer
+        DetachData();
+    }
+    if (o.m_zeroAreaEnd - o.m_zeroAreaStart > m_zeroAreaEnd - m_zeroAreaStart)
+    {
+        Buffer tmp = o;
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(Begin(), End());
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
     AddAtEnd(o.GetSize());
     Buffer::Iterator destStart = End();
     destStart.Prev(o.GetSize());
@@ -440,6 +471,29 @@ Buffer::AddAtEnd(const Buffer& o)
     NS_ASSERT(CheckInternalState());
 }
 
+void
+Buffer::DetachData()
+{
+    NS_LOG_FUNCTION(this);
+    struct Buffer::Data* newData = Buffer::Create(GetInternalSize());
+    memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
+    if (--m_data->m_count == 0)
+    {
+        Buffer::Recycle(m_data);
+    }
+    m_data = newData;
+
+    int32_t delta = -m_start;
+    m_zeroAreaStart += delta;
+    m_zeroAreaEnd += delta;
+    m_end += delta;
+    m_start += delta;
+
+    m_data->m_dirtyStart = m_start;
+    m_data->m_dirtyEnd = m_end;
+    NS_ASSERT(CheckInternalState());
+}
+
 void
 Buffer::RemoveAtStart(uint32_t start)
 {
@@ -835,25 +889,29 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // the written bytes are either before or after the zero area of this buffer
+    uint8_t* to = m_current <= m_zeroStart ? &m_data[m_current]
+                                           : &m_data[m_current - (m_zeroEnd - m_zeroStart)];
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
+        to += toCopy;
         m_current += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
+        to += toCopy;
         m_current += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
     m_current += toCopy;
 }
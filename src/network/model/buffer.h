@@ -25,7 +25,12 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#else
+// The free list is shared by all the threads
 #define BUFFER_FREE_LIST 1
+#endif
 
 namespace ns3
 {
@@ -66,10 +71,13 @@ namespace ns3
  * contains real data bytes in its BufferData instance but it also
  * contains "virtual zero data" which typically is used to represent
  * application-level payload. No memory is allocated to store the
- * zero bytes of application-level payload unless the user fragments
- * a Buffer: this application-level payload is kept track of with
+ * zero bytes of application-level payload unless the user writes
+ * into them: this application-level payload is kept track of with
  * a pair of integers which describe where in the buffer content
- * the "virtual zero area" starts and ends.
+ * the "virtual zero area" starts and ends. Fragments keep the part
+ * of the zero area they cover, and AddAtEnd merges adjacent zero
+ * areas; when a Buffer is appended whose zero area cannot be merged,
+ * only the larger of the two zero areas stays virtual.
  *
  * \verbatim
  * ***: unused bytes
@@ -665,7 +673,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -699,6 +711,12 @@ class Buffer
      * \brief Transform a "Virtual byte buffer" into a "Real byte buffer"
      */
     void TransformIntoRealBuffer() const;
+    /**
+     * \brief Copy the real bytes to a new Data referenced only by this Buffer.
+     *
+     * The zero area stays virtual.
+     */
+    void DetachData();
     /**
      * \brief Checks the internal buffer structures consistency
      *
@@ -769,7 +787,11 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -36,10 +36,26 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+#ifdef NS3_MTP
+std::atomic<bool> PacketMetadata::m_metadataSkipped = false;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
+#else
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
+#endif
+#ifdef NS3_MTP
+thread_local PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+
+namespace
+{
+/** Set when the free list of the thread is destroyed, at thread exit. */
+thread_local bool g_freeListDestroyed = false;
+} // unnamed namespace
+#else
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+#endif
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -48,7 +64,12 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
+#ifdef NS3_MTP
+    // The free lists of the other threads are still in use
+    g_freeListDestroyed = true;
+#else
     PacketMetadata::m_enable = false;
+#endif
 }
 
 void
@@ -80,8 +101,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     struct PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -99,13 +119,23 @@ PacketMetadata::ReserveCopy(uint32_t size)
     }
 }
 
+bool
+PacketMetadata::CanWriteInPlace() const
+{
+#ifdef NS3_MTP
+    // Another thread may be appending to the shared storage
+    return m_data->m_count == 1;
+#else
+    return m_data->m_count == 1 || m_data->m_dirtyEnd == m_used;
+#endif
+}
+
 void
 PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
-    if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+    if (m_data->m_size >= m_used + size && (m_head == 0xffff || CanWriteInPlace()))
     {
         /* enough room, not dirty. */
     }
@@ -384,8 +414,7 @@ PacketMetadata::AddSmall(const struct PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || (m_head != 0xffff && !CanWriteInPlace()))
     {
         ReserveCopy(n);
     }
@@ -421,8 +450,7 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || (m_head != 0xffff && !CanWriteInPlace()))
     {
         ReserveCopy(n);
     }
@@ -593,7 +621,11 @@ void
 PacketMetadata::Recycle(struct PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
+#ifdef NS3_MTP
+    if (!m_enable || g_freeListDestroyed)
+#else
     if (!m_enable)
+#endif
     {
         PacketMetadata::Deallocate(data);
         return;
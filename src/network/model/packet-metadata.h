@@ -29,6 +29,10 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -421,7 +425,11 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint16_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -606,6 +614,12 @@ class PacketMetadata
      * \param n space to reserve
      */
     void ReserveCopy(uint32_t n);
+    /**
+     * \brief Check whether the storage may be written after m_used
+     * \returns true if the storage is not shared, or if this instance
+     *          wrote its last bytes
+     */
+    inline bool CanWriteInPlace() const;
 
     /**
      * \brief Get the total size used by the metadata
@@ -670,19 +684,30 @@ class PacketMetadata
      */
     static void Deallocate(struct PacketMetadata::Data* data);
 
+#ifdef NS3_MTP
+    static thread_local DataFreeList m_freeList; //!< the metadata data storage of the thread
+#else
     static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+#endif
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
      * middle of a simulation, which isn't allowed.
      */
+#ifdef NS3_MTP
+    static std::atomic<bool> m_metadataSkipped;
+
+    static thread_local uint32_t m_maxSize;  //!< maximum metadata size
+    static thread_local uint16_t m_chunkUid; //!< Chunk Uid
+#else
     static bool m_metadataSkipped;
 
     static uint32_t m_maxSize;  //!< maximum metadata size
     static uint16_t m_chunkUid; //!< Chunk Uid
+#endif
 
     struct Data* m_data; //!< Metadata storage
     /*
@@ -734,8 +759,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
@@ -753,8 +777,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -121,7 +121,6 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 
     // At this point cur is a merge, but untested for tid
     NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
 
     /*
        Walk the remainder of the list, copying, until we find tid
@@ -149,8 +148,6 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     while (/* cur && */ cur->tid != tid)
     {
         NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
         struct TagData* copy = CreateTagData(cur->size);
         copy->tid = cur->tid;
         copy->count = 1;
@@ -160,12 +157,12 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
         copy->next->count++;    // mark new merge
         *prevNext = copy;       // point prior list at copy
         prevNext = &copy->next; // advance
+        ReleaseTagData(cur);    // unmerge cur
         cur = copy->next;
     }
     // Sanity check:
     NS_ASSERT(cur != nullptr);  // cur should be non-zero
     NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
 
     // link around tid, removing it from our list
     found = (this->*Writer)(tag, false, cur, prevNext);
@@ -201,13 +198,13 @@ PacketTagList::RemoveWriter(Tag& tag,
     else
     {
         // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
         if (cur->next != nullptr)
         {
             // there's a next, so make it a merge
             cur->next->count++;
         }
+        // unmerge cur, since we linked around it already
+        ReleaseTagData(cur);
     }
     return found;
 }
@@ -243,7 +240,6 @@ PacketTagList::ReplaceWriter(Tag& tag,
     {
         // cur is always a merge at this point
         // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
         struct TagData* copy = CreateTagData(tag.GetSerializedSize());
         copy->tid = tag.GetInstanceTypeId();
         copy->count = 1;
@@ -253,7 +249,8 @@ PacketTagList::ReplaceWriter(Tag& tag,
         {
             copy->next->count++; // mark new merge
         }
-        *prevNext = copy; // point prior list at copy
+        *prevNext = copy;    // point prior list at copy
+        ReleaseTagData(cur); // unmerge cur
     }
     return found;
 }
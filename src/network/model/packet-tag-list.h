@@ -29,6 +29,10 @@
 #include <ostream>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -142,7 +146,11 @@ class PacketTagList
     struct TagData
     {
         struct TagData* next; //!< Pointer to next in list
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< Number of incoming links
+#else
         uint32_t count;       //!< Number of incoming links
+#endif
         TypeId tid;           //!< Type of the tag serialized into #data
         uint32_t size;        //!< Size of the \c data buffer
         uint8_t data[1];      //!< Serialization buffer
@@ -253,6 +261,19 @@ class PacketTagList
      */
     static TagData* CreateTagData(size_t dataSize);
 
+    /**
+     * Release one link to a TagData struct, freeing it, and releasing its
+     * link to the next one, when it was the last link.
+     *
+     * With multithreaded simulation support (NS3_MTP), the lists sharing
+     * \pname{data} may release it concurrently, so the count is decremented
+     * atomically, and the last one to release it frees it, as in
+     * SimpleRefCount::Unref().
+     *
+     * \param [in] data The TagData struct.
+     */
+    static inline void ReleaseTagData(struct TagData* data);
+
     /**
      * Typedef of method function pointer for copy-on-write operations
      *
@@ -354,12 +375,22 @@ PacketTagList::~PacketTagList()
 
 void
 PacketTagList::RemoveAll()
+{
+    ReleaseTagData(m_next);
+    m_next = nullptr;
+}
+
+void
+PacketTagList::ReleaseTagData(struct TagData* data)
 {
     struct TagData* prev = nullptr;
-    for (struct TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (struct TagData* cur = data; cur != nullptr; cur = cur->next)
     {
-        cur->count--;
-        if (cur->count > 0)
+#ifdef NS3_MTP
+        if (cur->count.fetch_sub(1, std::memory_order_acq_rel) > 1)
+#else
+        if (--cur->count > 0)
+#endif
         {
             break;
         }
@@ -375,7 +406,6 @@ PacketTagList::RemoveAll()
         prev->~TagData();
         std::free(prev);
     }
-    m_next = nullptr;
 }
 
 } // namespace ns3
@@ -36,6 +36,10 @@
 
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -261,8 +265,10 @@ class Packet : public SimpleRefCount<Packet>
      *
      * The memory necessary for the payload is not allocated:
      * it will be allocated at any later point if you attempt
-     * to fragment this packet or to access the zero-filled
-     * bytes. The packet is allocated with a new uid (as
+     * to access the zero-filled bytes. Fragments of the packet,
+     * and the concatenation of such fragments with AddAtEnd,
+     * keep the payload virtual, and pcap traces write it as
+     * zeros. The packet is allocated with a new uid (as
      * returned by getUid).
      *
      * \param size the size of the zero-filled payload
@@ -539,6 +545,23 @@ class Packet : public SimpleRefCount<Packet>
      */
     static void EnableChecking();
 
+#ifdef NS3_MTP
+    /**
+     * \brief Set the uid counter of the calling thread.
+     *
+     * The packets created by the thread take their uid from
+     * \pname{counter}, which is incremented, instead of the global
+     * counter. The multithreaded simulator gives each logical process its
+     * own counter, starting at the index of the logical process shifted
+     * by 32 bits, and sets it while the logical process runs, so that the
+     * packet uids of each logical process are unique, and do not depend
+     * on the thread scheduling.
+     *
+     * \param [in] counter The counter, or nullptr to use the global counter.
+     */
+    static void SetUidCounter(uint64_t* counter);
+#endif
+
     /**
      * \brief Returns number of bytes required for packet
      * serialization.
@@ -789,6 +812,17 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * \brief Allocate the uid of a new packet.
+     *
+     * The upper 32 bits of the packet uid are the system id, which is zero
+     * for non-distributed simulations; the lower 32 bits are taken from
+     * the global counter.
+     *
+     * \returns The packet uid.
+     */
+    static uint64_t AllocateUid();
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -797,7 +831,11 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
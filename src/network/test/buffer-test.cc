@@ -337,6 +337,37 @@ BufferTest::DoRun()
     ENSURE_WRITTEN_BYTES(buffer, 7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x66);
     ENSURE_WRITTEN_BYTES(frag0, 7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x66);
 
+    // fragments of a zero area are merged back without writing zeros
+    buffer = Buffer(10000);
+    frag0 = buffer.CreateFragment(0, 6000);
+    frag1 = buffer.CreateFragment(6000, 4000);
+    frag0.AddAtEnd(frag1);
+    NS_TEST_ASSERT_MSG_EQ(frag0.GetSize(), 10000, "Buffer bad size");
+    NS_TEST_ASSERT_MSG_EQ(frag0.GetSerializedSize(), 12, "zero area not kept");
+    frag1.AddAtEnd(frag1.CreateFragment(0, 2000));
+    NS_TEST_ASSERT_MSG_EQ(frag1.GetSize(), 6000, "Buffer bad size");
+    NS_TEST_ASSERT_MSG_EQ(frag1.GetSerializedSize(), 12, "zero area not kept");
+
+    // when the zero areas cannot be merged, the larger one is kept
+    buffer = Buffer(3);
+    buffer.AddAtEnd(2);
+    i = buffer.End();
+    i.Prev(2);
+    i.WriteU8(0x1);
+    i.WriteU8(0x2);
+    Buffer large = Buffer(6);
+    large.AddAtStart(1);
+    large.Begin().WriteU8(0x3);
+    buffer.AddAtEnd(large);
+    ENSURE_WRITTEN_BYTES(buffer, 12, 0, 0, 0, 0x1, 0x2, 0x3, 0, 0, 0, 0, 0, 0);
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSerializedSize(), 12 + 8, "larger zero area not kept");
+    Buffer small = Buffer(2);
+    small.AddAtStart(1);
+    small.Begin().WriteU8(0x4);
+    large.AddAtEnd(small);
+    ENSURE_WRITTEN_BYTES(large, 10, 0x3, 0, 0, 0, 0, 0, 0, 0x4, 0, 0);
+    NS_TEST_ASSERT_MSG_EQ(large.GetSerializedSize(), 12 + 4 + 4, "larger zero area not kept");
+
     buffer = Buffer(5);
     buffer.AddAtStart(2);
     i = buffer.Begin();
@@ -16,9 +16,12 @@
  */
 
 #include "ns3/drop-tail-queue.h"
+#include "ns3/ring-buffer.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <list>
+
 using namespace ns3;
 
 /**
@@ -87,6 +90,168 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that a RingBuffer behaves as a std::list when wrapping around and
+ * growing, and with insertions and erasures at any position.
+ */
+class RingBufferTestCase : public TestCase
+{
+  public:
+    RingBufferTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Check that a RingBuffer holds the same elements as a list.
+     * \param buffer The RingBuffer.
+     * \param reference The list.
+     * \param step The step of the test, for the messages.
+     */
+    void Check(const RingBuffer<int>& buffer, const std::list<int>& reference, uint32_t step);
+};
+
+RingBufferTestCase::RingBufferTestCase()
+    : TestCase("Check the ring buffer container")
+{
+}
+
+void
+RingBufferTestCase::Check(const RingBuffer<int>& buffer,
+                          const std::list<int>& reference,
+                          uint32_t step)
+{
+    NS_TEST_ASSERT_MSG_EQ(buffer.size(), reference.size(), "Wrong size at step " << step);
+    auto it = buffer.begin();
+    for (int value : reference)
+    {
+        NS_TEST_ASSERT_MSG_EQ(*it, value, "Wrong element at step " << step);
+        ++it;
+    }
+    NS_TEST_EXPECT_MSG_EQ((it == buffer.end()), true, "Wrong end at step " << step);
+}
+
+void
+RingBufferTestCase::DoRun()
+{
+    RingBuffer<int> buffer;
+    std::list<int> reference;
+
+    // FIFO use wraps around without growing
+    for (int i = 0; i < 6; i++)
+    {
+        buffer.insert(buffer.end(), i);
+        reference.push_back(i);
+    }
+    std::size_t capacity = buffer.capacity();
+    for (int i = 6; i < 100; i++)
+    {
+        buffer.erase(buffer.begin());
+        reference.pop_front();
+        buffer.insert(buffer.end(), i);
+        reference.push_back(i);
+        Check(buffer, reference, i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), capacity, "A FIFO use should not grow the buffer");
+
+    // Growing keeps the order of the elements
+    for (int i = 100; i < 150; i++)
+    {
+        buffer.insert(buffer.end(), i);
+        reference.push_back(i);
+    }
+    Check(buffer, reference, 150);
+    NS_TEST_EXPECT_MSG_GT(buffer.capacity(), capacity, "The buffer should have grown");
+
+    // Insertions and erasures in the first and in the second half
+    for (uint32_t step = 0; step < 40; step++)
+    {
+        std::size_t index = (step * 7) % buffer.size();
+        auto refIt = std::next(reference.begin(), index);
+        if (step % 3 == 0)
+        {
+            reference.erase(refIt);
+            auto it = buffer.erase(buffer.begin() + index);
+            NS_TEST_EXPECT_MSG_EQ(std::size_t(it - buffer.begin()),
+                                  index,
+                                  "Wrong position after erase");
+        }
+        else
+        {
+            int value = 1000 + step;
+            reference.insert(refIt, value);
+            auto it = buffer.insert(buffer.begin() + index, value);
+            NS_TEST_EXPECT_MSG_EQ(*it, value, "Wrong element after insert");
+        }
+        Check(buffer, reference, 200 + step);
+    }
+
+    buffer.clear();
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "The buffer should be empty");
+    NS_TEST_EXPECT_MSG_GT(buffer.capacity(), capacity, "Clearing should keep the capacity");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check a DropTailQueue whose maximum size is in bytes, which holds more
+ * packets than the initial capacity of its container, across many rounds.
+ */
+class DropTailQueueBytesTestCase : public TestCase
+{
+  public:
+    DropTailQueueBytesTestCase();
+    void DoRun() override;
+};
+
+DropTailQueueBytesTestCase::DropTailQueueBytesTestCase()
+    : TestCase("Check the drop tail queue with a maximum size in bytes")
+{
+}
+
+void
+DropTailQueueBytesTestCase::DoRun()
+{
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetMaxSize(QueueSize("1000B"));
+
+    std::list<uint64_t> uids;
+    for (uint32_t round = 0; round < 20; round++)
+    {
+        // Small packets fill the queue up to its size in bytes
+        uint32_t size = 10 + round % 3 * 20;
+        while (true)
+        {
+            Ptr<Packet> p = Create<Packet>(size);
+            if (!queue->Enqueue(p))
+            {
+                break;
+            }
+            uids.push_back(p->GetUid());
+        }
+        NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), uids.size(), "Wrong number of packets");
+        NS_TEST_EXPECT_MSG_EQ((queue->GetNBytes() > 1000 - size), true, "The queue should be full");
+
+        // Dequeue half of the packets, in FIFO order
+        for (std::size_t i = uids.size() / 2; i > 0; i--)
+        {
+            Ptr<Packet> p = queue->Dequeue();
+            NS_TEST_ASSERT_MSG_NE(p, nullptr, "There should be a packet");
+            NS_TEST_EXPECT_MSG_EQ(p->GetUid(), uids.front(), "Wrong packet order");
+            uids.pop_front();
+        }
+    }
+    while (Ptr<Packet> p = queue->Dequeue())
+    {
+        NS_TEST_EXPECT_MSG_EQ(p->GetUid(), uids.front(), "Wrong packet order");
+        uids.pop_front();
+    }
+    NS_TEST_EXPECT_MSG_EQ(uids.empty(), true, "Packets were lost");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -100,6 +265,8 @@ class DropTailQueueTestSuite : public TestSuite
         : TestSuite("drop-tail-queue", UNIT)
     {
         AddTestCase(new DropTailQueueTestCase(), TestCase::QUICK);
+        AddTestCase(new DropTailQueueBytesTestCase(), TestCase::QUICK);
+        AddTestCase(new RingBufferTestCase(), TestCase::QUICK);
     }
 };
 
@@ -245,7 +245,10 @@ class QueueBase : public Object
  * container used internally to store queue items. The container type must provide
  * the methods insert(), erase() and clear() and define the iterator and const_iterator
  * types, following the usual syntax of C++ containers. The default container type
- * is std::list (as defined in queue-fwd.h). In case the container is such that
+ * is RingBuffer (as defined in queue-fwd.h), which only moves elements when
+ * items are inserted or removed at positions other than the ends of the queue;
+ * subclasses which do so often may prefer std::list. Note that, with RingBuffer,
+ * inserting or erasing an item invalidates the iterators to the other items. In case the container is such that
  * an object stored within the queue is obtained from a container element through
  * an operation other than dereferencing an iterator pointing to the container
  * element, the container has to provide a public method named GetItem that
@@ -0,0 +1,606 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup queue
+ * ns3::RingBuffer declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup queue
+ *
+ * \brief A sequence container stored in a circular array.
+ *
+ * RingBuffer provides the subset of the std::list interface used by the
+ * Queue class (begin(), end(), insert(), erase(), clear() and the iterator
+ * and const_iterator types), so that it can be used as the Container
+ * template parameter of Queue, and it is the default container of Queue
+ * (see queue-fwd.h).
+ *
+ * The elements are stored in an array whose capacity is a power of two.
+ * Inserting at the end and erasing at the beginning, as a FIFO queue does,
+ * take constant time and do not allocate memory once the capacity has grown
+ * to the largest occupancy of the queue: with a MaxSize in packets the
+ * capacity is then fixed, while with a MaxSize in bytes it follows the
+ * number of packets that fit in the queue. Inserting or erasing elsewhere
+ * moves the elements between the position and the nearest end.
+ *
+ * Unlike with std::list, insert() and erase() invalidate all the iterators
+ * (the iterators are positions in the sequence: after an insertion or an
+ * erasure, an iterator refers to the element now at its position).
+ *
+ * \tparam T \explicit The type of the elements, which must be default
+ *         constructible and move assignable; a default constructed element
+ *         fills the unused slots of the array.
+ */
+template <typename T>
+class RingBuffer
+{
+  public:
+    typedef T value_type;                   //!< Element type
+    typedef std::size_t size_type;          //!< Size type
+    typedef std::ptrdiff_t difference_type; //!< Difference type
+    typedef T& reference;                   //!< Element reference
+    typedef const T& const_reference;       //!< Element const reference
+
+    /**
+     * \brief Random access iterator on the elements of a RingBuffer.
+     *
+     * \tparam Const \explicit Whether the iterator gives const access.
+     */
+    template <bool Const>
+    class Iter
+    {
+      public:
+        /// Type of the iterated RingBuffer
+        typedef std::conditional_t<Const, const RingBuffer, RingBuffer> Buffer;
+
+        typedef std::random_access_iterator_tag iterator_category; //!< Category
+        typedef T value_type;                                      //!< Element type
+        typedef std::ptrdiff_t difference_type;                    //!< Difference type
+        typedef std::conditional_t<Const, const T*, T*> pointer;   //!< Element pointer
+        typedef std::conditional_t<Const, const T&, T&> reference; //!< Element reference
+
+        /** Default constructor, for an iterator to be assigned later. */
+        Iter()
+            : m_buffer(nullptr),
+              m_index(0)
+        {
+        }
+
+        /**
+         * Constructor.
+         * \param [in] buffer The iterated RingBuffer.
+         * \param [in] index The position in the sequence.
+         */
+        Iter(Buffer* buffer, std::size_t index)
+            : m_buffer(buffer),
+              m_index(index)
+        {
+        }
+
+        /**
+         * Conversion of an iterator to a const iterator.
+         * \param [in] other The iterator.
+         */
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        Iter(const Iter<OtherConst>& other)
+            : m_buffer(other.m_buffer),
+              m_index(other.m_index)
+        {
+        }
+
+        /** \returns The element. */
+        reference operator*() const
+        {
+            return (*m_buffer)[m_index];
+        }
+
+        /** \returns A pointer to the element. */
+        pointer operator->() const
+        {
+            return &(*m_buffer)[m_index];
+        }
+
+        /**
+         * \param [in] n The offset.
+         * \returns The element at the given offset.
+         */
+        reference operator[](difference_type n) const
+        {
+            return (*m_buffer)[m_index + n];
+        }
+
+        /** \returns This iterator, moved to the next element. */
+        Iter& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        /** \returns A copy of this iterator, before moving it to the next element. */
+        Iter operator++(int)
+        {
+            Iter copy = *this;
+            ++m_index;
+            return copy;
+        }
+
+        /** \returns This iterator, moved to the previous element. */
+        Iter& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        /** \returns A copy of this iterator, before moving it to the previous element. */
+        Iter operator--(int)
+        {
+            Iter copy = *this;
+            --m_index;
+            return copy;
+        }
+
+        /**
+         * \param [in] n The offset.
+         * \returns This iterator, moved by the given offset.
+         */
+        Iter& operator+=(difference_type n)
+        {
+            m_index += n;
+            return *this;
+        }
+
+        /**
+         * \param [in] n The offset.
+         * \returns This iterator, moved back by the given offset.
+         */
+        Iter& operator-=(difference_type n)
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        /**
+         * \param [in] n The offset.
+         * \returns An iterator moved by the given offset.
+         */
+        Iter operator+(difference_type n) const
+        {
+            return Iter(m_buffer, m_index + n);
+        }
+
+        /**
+         * \param [in] n The offset.
+         * \returns An iterator moved back by the given offset.
+         */
+        Iter operator-(difference_type n) const
+        {
+            return Iter(m_buffer, m_index - n);
+        }
+
+        /**
+         * \param [in] other Another iterator on the same RingBuffer.
+         * \returns The distance from the other iterator.
+         */
+        difference_type operator-(const Iter& other) const
+        {
+            return difference_type(m_index) - difference_type(other.m_index);
+        }
+
+        /**
+         * \param [in] other Another iterator.
+         * \returns True if both iterators are at the same position.
+         */
+        bool operator==(const Iter& other) const
+        {
+            return m_buffer == other.m_buffer && m_index == other.m_index;
+        }
+
+        /**
+         * \param [in] other Another iterator.
+         * \returns True if the iterators are at different positions.
+         */
+        bool operator!=(const Iter& other) const
+        {
+            return !(*this == other);
+        }
+
+        /**
+         * \param [in] other Another iterator on the same RingBuffer.
+         * \returns True if this iterator is before the other one.
+         */
+        bool operator<(const Iter& other) const
+        {
+            return m_index < other.m_index;
+        }
+
+      private:
+        friend class RingBuffer;
+        friend class Iter<!Const>;
+
+        Buffer* m_buffer;    //!< The iterated RingBuffer
+        std::size_t m_index; //!< The position in the sequence
+    };
+
+    typedef Iter<false> iterator;      //!< Iterator
+    typedef Iter<true> const_iterator; //!< Const iterator
+
+    RingBuffer();
+
+    /** \returns An iterator to the first element. */
+    iterator begin();
+    /** \returns An iterator past the last element. */
+    iterator end();
+    /** \returns A const iterator to the first element. */
+    const_iterator begin() const;
+    /** \returns A const iterator past the last element. */
+    const_iterator end() const;
+    /** \returns A const iterator to the first element. */
+    const_iterator cbegin() const;
+    /** \returns A const iterator past the last element. */
+    const_iterator cend() const;
+
+    /** \returns The number of elements. */
+    size_type size() const;
+    /** \returns True if there is no element. */
+    bool empty() const;
+    /** \returns The number of elements that fit without allocating memory. */
+    size_type capacity() const;
+
+    /**
+     * \param [in] n The position in the sequence.
+     * \returns The element at the given position.
+     */
+    reference operator[](size_type n);
+    /**
+     * \param [in] n The position in the sequence.
+     * \returns The element at the given position.
+     */
+    const_reference operator[](size_type n) const;
+    /** \returns The first element. */
+    reference front();
+    /** \returns The first element. */
+    const_reference front() const;
+    /** \returns The last element. */
+    reference back();
+    /** \returns The last element. */
+    const_reference back() const;
+
+    /**
+     * Make room for at least the given number of elements.
+     * \param [in] n The number of elements.
+     */
+    void reserve(size_type n);
+
+    /**
+     * Insert an element.
+     * \param [in] pos The position before which the element is inserted.
+     * \param [in] value The element.
+     * \returns An iterator to the inserted element.
+     */
+    iterator insert(const_iterator pos, const T& value);
+
+    /**
+     * Erase an element.
+     * \param [in] pos The position of the element.
+     * \returns An iterator to the element which followed the erased one.
+     */
+    iterator erase(const_iterator pos);
+
+    /**
+     * Append an element.
+     * \param [in] value The element.
+     */
+    void push_back(const T& value);
+
+    /** Erase the first element. */
+    void pop_front();
+
+    /** Erase all the elements, keeping the capacity. */
+    void clear();
+
+  private:
+    /**
+     * \param [in] n The position in the sequence.
+     * \returns The slot of the array holding the element at the given position.
+     */
+    T& Slot(size_type n);
+
+    /**
+     * Double the capacity (at least a few elements), moving the elements
+     * to the beginning of a new array.
+     * \param [in] n The minimum capacity.
+     */
+    void Grow(size_type n);
+
+    std::vector<T> m_slots; //!< The array, whose size is a power of two
+    size_type m_head;       //!< Index in the array of the first element
+    size_type m_size;       //!< Number of elements
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename T>
+RingBuffer<T>::RingBuffer()
+    : m_head(0),
+      m_size(0)
+{
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::begin()
+{
+    return iterator(this, 0);
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::end()
+{
+    return iterator(this, m_size);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::end() const
+{
+    return const_iterator(this, m_size);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::cbegin() const
+{
+    return begin();
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::cend() const
+{
+    return end();
+}
+
+template <typename T>
+typename RingBuffer<T>::size_type
+RingBuffer<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+bool
+RingBuffer<T>::empty() const
+{
+    return m_size == 0;
+}
+
+template <typename T>
+typename RingBuffer<T>::size_type
+RingBuffer<T>::capacity() const
+{
+    return m_slots.size();
+}
+
+template <typename T>
+T&
+RingBuffer<T>::Slot(size_type n)
+{
+    return m_slots[(m_head + n) & (m_slots.size() - 1)];
+}
+
+template <typename T>
+typename RingBuffer<T>::reference
+RingBuffer<T>::operator[](size_type n)
+{
+    NS_ASSERT_MSG(n < m_size, "Position " << n << " out of " << m_size << " elements");
+    return Slot(n);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_reference
+RingBuffer<T>::operator[](size_type n) const
+{
+    NS_ASSERT_MSG(n < m_size, "Position " << n << " out of " << m_size << " elements");
+    return m_slots[(m_head + n) & (m_slots.size() - 1)];
+}
+
+template <typename T>
+typename RingBuffer<T>::reference
+RingBuffer<T>::front()
+{
+    return (*this)[0];
+}
+
+template <typename T>
+typename RingBuffer<T>::const_reference
+RingBuffer<T>::front() const
+{
+    return (*this)[0];
+}
+
+template <typename T>
+typename RingBuffer<T>::reference
+RingBuffer<T>::back()
+{
+    return (*this)[m_size - 1];
+}
+
+template <typename T>
+typename RingBuffer<T>::const_reference
+RingBuffer<T>::back() const
+{
+    return (*this)[m_size - 1];
+}
+
+template <typename T>
+void
+RingBuffer<T>::Grow(size_type n)
+{
+    size_type capacity = m_slots.empty() ? 8 : m_slots.size() * 2;
+    while (capacity < n)
+    {
+        capacity *= 2;
+    }
+    std::vector<T> slots(capacity);
+    for (size_type i = 0; i < m_size; i++)
+    {
+        slots[i] = std::move(Slot(i));
+    }
+    m_slots.swap(slots);
+    m_head = 0;
+}
+
+template <typename T>
+void
+RingBuffer<T>::reserve(size_type n)
+{
+    if (n > m_slots.size())
+    {
+        Grow(n);
+    }
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::insert(const_iterator pos, const T& value)
+{
+    size_type index = pos.m_index;
+    NS_ASSERT_MSG(pos.m_buffer == this && index <= m_size, "Invalid insert position");
+    if (m_size == m_slots.size())
+    {
+        Grow(m_size + 1);
+    }
+    if (index == m_size)
+    {
+        // Append, as a FIFO queue does
+        m_slots[(m_head + index) & (m_slots.size() - 1)] = value;
+        m_size++;
+        return iterator(this, index);
+    }
+    if (index < m_size / 2)
+    {
+        // Move the elements before the position one slot backward
+        m_head = (m_head - 1) & (m_slots.size() - 1);
+        for (size_type i = 0; i < index; i++)
+        {
+            Slot(i) = std::move(Slot(i + 1));
+        }
+    }
+    else
+    {
+        // Move the elements from the position one slot forward
+        for (size_type i = m_size; i > index; i--)
+        {
+            Slot(i) = std::move(Slot(i - 1));
+        }
+    }
+    Slot(index) = value;
+    m_size++;
+    return iterator(this, index);
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::erase(const_iterator pos)
+{
+    size_type index = pos.m_index;
+    NS_ASSERT_MSG(pos.m_buffer == this && index < m_size, "Invalid erase position");
+    if (index == 0)
+    {
+        // Erase the first element, as a FIFO queue does
+        m_slots[m_head] = T();
+        m_head = (m_head + 1) & (m_slots.size() - 1);
+        m_size--;
+        return iterator(this, 0);
+    }
+    if (index < m_size / 2)
+    {
+        // Move the elements before the position one slot forward
+        for (size_type i = index; i > 0; i--)
+        {
+            Slot(i) = std::move(Slot(i - 1));
+        }
+        Slot(0) = T();
+        m_head = (m_head + 1) & (m_slots.size() - 1);
+    }
+    else
+    {
+        // Move the elements after the position one slot backward
+        for (size_type i = index; i + 1 < m_size; i++)
+        {
+            Slot(i) = std::move(Slot(i + 1));
+        }
+        Slot(m_size - 1) = T();
+    }
+    m_size--;
+    return iterator(this, index);
+}
+
+template <typename T>
+void
+RingBuffer<T>::push_back(const T& value)
+{
+    insert(end(), value);
+}
+
+template <typename T>
+void
+RingBuffer<T>::pop_front()
+{
+    erase(begin());
+}
+
+template <typename T>
+void
+RingBuffer<T>::clear()
+{
+    for (size_type i = 0; i < m_size; i++)
+    {
+        Slot(i) = T();
+    }
+    m_head = 0;
+    m_size = 0;
+}
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
@@ -247,6 +247,78 @@ TracedValueCallbackTestCase::DoRun()
     CheckType<SequenceNumber32, TracedValueCallback::SequenceNumber32>();
 }
 
+/**
+ * \ingroup system-tests-traced
+ *
+ * Check the TracedValue policies: a traced value calls its sinks only on
+ * changes, an elided value is a plain value which ignores its sinks, and
+ * both mix in expressions.
+ */
+class TracedValuePolicyTestCase : public TestCase
+{
+  public:
+    TracedValuePolicyTestCase();
+
+  private:
+    /**
+     * Count the calls of the sink.
+     *
+     * \param [in] oldValue The old value.
+     * \param [in] newValue The new value.
+     */
+    void Sink(uint32_t oldValue [[maybe_unused]], uint32_t newValue)
+    {
+        m_calls++;
+        m_last = newValue;
+    }
+
+    void DoRun() override;
+
+    uint32_t m_calls; //!< Number of calls of the sink
+    uint32_t m_last;  //!< Last new value passed to the sink
+};
+
+TracedValuePolicyTestCase::TracedValuePolicyTestCase()
+    : TestCase("Check the traced and elided TracedValue policies"),
+      m_calls(0),
+      m_last(0)
+{
+}
+
+void
+TracedValuePolicyTestCase::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(sizeof(TracedValue<uint32_t, TracedValuePolicy::Elided>),
+                          sizeof(uint32_t),
+                          "An elided TracedValue should be a plain value");
+
+    TracedValue<uint32_t> traced(1);
+    traced = 2;
+    traced.ConnectWithoutContext(MakeCallback(&TracedValuePolicyTestCase::Sink, this));
+    traced = 2;
+    NS_TEST_EXPECT_MSG_EQ(m_calls, 0, "The sink should not be called without a change");
+    traced += 3;
+    NS_TEST_EXPECT_MSG_EQ(m_calls, 1, "The sink should be called on a change");
+    NS_TEST_EXPECT_MSG_EQ(m_last, 5, "Wrong new value");
+    traced.DisconnectWithoutContext(MakeCallback(&TracedValuePolicyTestCase::Sink, this));
+    traced++;
+    NS_TEST_EXPECT_MSG_EQ(m_calls, 1, "The sink should be disconnected");
+
+    TracedValue<uint32_t, TracedValuePolicy::Elided> elided(1);
+    elided.ConnectWithoutContext(MakeCallback(&TracedValuePolicyTestCase::Sink, this));
+    elided = 7;
+    elided *= 2;
+    elided--;
+    NS_TEST_EXPECT_MSG_EQ(m_calls, 1, "An elided value should not call its sinks");
+    NS_TEST_EXPECT_MSG_EQ(elided.Get(), 13, "Wrong elided value");
+
+    TracedValue<uint32_t> sum = elided + traced;
+    NS_TEST_EXPECT_MSG_EQ(sum.Get(), 19, "Wrong sum of the policies");
+    NS_TEST_EXPECT_MSG_EQ((elided > traced), true, "Wrong comparison of the policies");
+    traced = elided;
+    NS_TEST_EXPECT_MSG_EQ(traced.Get(), 13, "Wrong assignment across the policies");
+}
+
 /**
  * \ingroup system-tests-traced
  *
@@ -262,6 +334,7 @@ TracedValueCallbackTestSuite::TracedValueCallbackTestSuite()
     : TestSuite("traced-value-callback", UNIT)
 {
     AddTestCase(new TracedValueCallbackTestCase, TestCase::QUICK);
+    AddTestCase(new TracedValuePolicyTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
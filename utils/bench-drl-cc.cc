@@ -0,0 +1,605 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Simulation throughput benchmark of the DRL congestion control workload.
+ *
+ * Runs the dumbbell of scratch/tcp/tcp-pcc-aurora/sim.cc with N flows:
+ *
+ *   Left leaves (senders)                     Right leaves (sinks)
+ *           |            \                    /        |
+ *           |             \    bottleneck    /         |
+ *           |              R0--------------R1          |
+ *           |             /                  \         |
+ *           |   access   /                    \ access |
+ *           N -----------                      --------N
+ *
+ * with 100 Mb/s, 0.1 ms access links and a 12 Mb/s, 30 ms bottleneck with
+ * a 128 packet queue, whose rate is drawn from a log-normal distribution
+ * every second, as in sim.cc. Each flow is a bulk TCP transfer using one of:
+ *
+ *  - aurora-stub: a rate-based congestion control with the structure of
+ *    TcpPccAurora (per-packet sent, acked and lost events aggregated in
+ *    monitor intervals, pacing at the sending rate), whose rate controller
+ *    is a local stub instead of the agent behind the OpenGym interface;
+ *  - newreno, cubic, bbr: the ns-3 congestion controls.
+ *
+ * Each configuration runs in its own process, so that the peak resident
+ * set size is its own, and the results are written as JSON:
+ *
+ *   {
+ *     "benchmark": "bench-drl-cc",
+ *     "duration": 10,
+ *     "results": [
+ *       { "cc": "newreno", "flows": 1, "events": ..., "wall_s": ...,
+ *         "events_per_s": ..., "sim_s_per_wall_s": ..., "packets": ...,
+ *         "ns_per_packet": ..., "peak_rss_kb": ... },
+ *       ...
+ *     ]
+ *   }
+ *
+ * "packets" counts the packet transmissions on all the links, and
+ * "ns_per_packet" is the wall-clock time per such transmission.
+ */
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BenchDrlCc");
+
+/**
+ * Rate-based congestion control with the structure of TcpPccAurora, and a
+ * stub rate controller.
+ *
+ * The segments sent, acked and lost are accounted in monitor intervals of
+ * about one RTT. At the end of each interval, the rate controller computes
+ * the next sending rate from the loss rate and the RTT gradient of the
+ * interval, as the agent does from its observations, with a fixed policy:
+ * decrease on losses or growing RTT, increase otherwise.
+ */
+class BenchAuroraStub : public TcpCongestionOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    BenchAuroraStub();
+
+    /**
+     * \brief Copy constructor.
+     * \param sock object to copy.
+     */
+    BenchAuroraStub(const BenchAuroraStub& sock);
+
+    std::string GetName() const override;
+    uint32_t GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight) override;
+    Ptr<TcpCongestionOps> Fork() override;
+    bool HasPacketEvents() const override;
+    void OnPacketSent(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t size,
+                      const Time& sentTime) override;
+    void OnPacketAcked(Ptr<TcpSocketState> tcb,
+                       SequenceNumber32 seq,
+                       uint32_t size,
+                       const Time& sentTime) override;
+    void OnPacketLost(Ptr<TcpSocketState> tcb,
+                      SequenceNumber32 seq,
+                      uint32_t size,
+                      const Time& sentTime) override;
+
+  private:
+    /** Statistics of a monitor interval. */
+    struct Interval
+    {
+        Time m_end;               //!< End of the interval
+        uint64_t m_sent{0};       //!< Bytes sent
+        uint64_t m_acked{0};      //!< Bytes acked
+        uint64_t m_lost{0};       //!< Bytes lost
+        double m_rttSum{0};       //!< Sum of the RTT samples, in seconds
+        uint32_t m_rttSamples{0}; //!< Number of RTT samples
+    };
+
+    /**
+     * The stub rate controller: compute the next sending rate.
+     * \param [in] interval The finished interval.
+     */
+    void UpdateSendingRate(const Interval& interval);
+
+    /**
+     * Set the pacing rate and the congestion window from the sending rate.
+     * \param [in] tcb The congestion state.
+     */
+    void UpdatePacingRate(Ptr<TcpSocketState> tcb);
+
+    DataRate m_sendingRate; //!< Current sending rate
+    Interval m_interval;    //!< Current monitor interval
+    double m_lastRtt;       //!< Mean RTT of the previous interval, in seconds
+    Time m_rtt;             //!< Smoothed RTT
+};
+
+NS_OBJECT_ENSURE_REGISTERED(BenchAuroraStub);
+
+TypeId
+BenchAuroraStub::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::BenchAuroraStub")
+                            .SetParent<TcpCongestionOps>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<BenchAuroraStub>();
+    return tid;
+}
+
+BenchAuroraStub::BenchAuroraStub()
+    : m_sendingRate("512Kbps"),
+      m_lastRtt(0),
+      m_rtt(MilliSeconds(100))
+{
+}
+
+BenchAuroraStub::BenchAuroraStub(const BenchAuroraStub& sock)
+    : TcpCongestionOps(sock),
+      m_sendingRate(sock.m_sendingRate),
+      m_lastRtt(0),
+      m_rtt(sock.m_rtt)
+{
+}
+
+std::string
+BenchAuroraStub::GetName() const
+{
+    return "BenchAuroraStub";
+}
+
+uint32_t
+BenchAuroraStub::GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
+{
+    return tcb->m_ssThresh;
+}
+
+Ptr<TcpCongestionOps>
+BenchAuroraStub::Fork()
+{
+    return CopyObject<BenchAuroraStub>(this);
+}
+
+bool
+BenchAuroraStub::HasPacketEvents() const
+{
+    return true;
+}
+
+void
+BenchAuroraStub::UpdateSendingRate(const Interval& interval)
+{
+    double loss =
+        interval.m_sent > 0 ? static_cast<double>(interval.m_lost) / interval.m_sent : 0;
+    double rtt = interval.m_rttSamples > 0 ? interval.m_rttSum / interval.m_rttSamples : 0;
+    double gradient = (m_lastRtt > 0 && rtt > 0) ? (rtt - m_lastRtt) / m_lastRtt : 0;
+    if (rtt > 0)
+    {
+        m_lastRtt = rtt;
+    }
+    double factor = 1.05;
+    if (loss > 0.05)
+    {
+        factor = 0.9;
+    }
+    else if (gradient > 0.01)
+    {
+        factor = 0.97;
+    }
+    uint64_t rate = static_cast<uint64_t>(m_sendingRate.GetBitRate() * factor);
+    m_sendingRate = DataRate(std::max<uint64_t>(rate, 100000));
+}
+
+void
+BenchAuroraStub::UpdatePacingRate(Ptr<TcpSocketState> tcb)
+{
+    tcb->m_pacing = true;
+    tcb->m_pacingRate = m_sendingRate * 1.1;
+    tcb->m_maxPacingRate = m_sendingRate * 1.1;
+    Time rtt = tcb->m_minRtt != Time::Max() ? tcb->m_minRtt : MilliSeconds(1);
+    uint32_t cWnd = std::max<uint32_t>(m_sendingRate.GetBitRate() * rtt.GetSeconds() / 8 * 1.1,
+                                       2 * tcb->m_segmentSize);
+    tcb->m_cWnd = cWnd;
+    tcb->m_ssThresh = cWnd;
+}
+
+void
+BenchAuroraStub::OnPacketSent(Ptr<TcpSocketState> tcb,
+                              SequenceNumber32 seq,
+                              uint32_t size,
+                              const Time& sentTime)
+{
+    if (sentTime >= m_interval.m_end)
+    {
+        UpdateSendingRate(m_interval);
+        m_interval = Interval();
+        m_interval.m_end = sentTime + std::max(m_rtt, MilliSeconds(10));
+        UpdatePacingRate(tcb);
+    }
+    m_interval.m_sent += size;
+}
+
+void
+BenchAuroraStub::OnPacketAcked(Ptr<TcpSocketState> tcb,
+                               SequenceNumber32 seq,
+                               uint32_t size,
+                               const Time& sentTime)
+{
+    Time rtt = Simulator::Now() - sentTime;
+    m_rtt = (m_rtt * 7 + rtt) / 8;
+    m_interval.m_acked += size;
+    m_interval.m_rttSum += rtt.GetSeconds();
+    m_interval.m_rttSamples++;
+}
+
+void
+BenchAuroraStub::OnPacketLost(Ptr<TcpSocketState> tcb,
+                              SequenceNumber32 seq,
+                              uint32_t size,
+                              const Time& sentTime)
+{
+    m_interval.m_lost += size;
+}
+
+/** The result of a benchmark run. */
+struct Result
+{
+    std::string cc;       //!< Congestion control
+    uint32_t flows;       //!< Number of flows
+    uint64_t events;      //!< Number of events executed
+    double wall;          //!< Wall-clock time of Simulator::Run, in seconds
+    uint64_t packets;     //!< Packet transmissions on all the links
+    uint64_t peakRss;     //!< Peak resident set size, in kB
+};
+
+/** The number of packet transmissions on all the links. */
+uint64_t g_packets = 0;
+
+/**
+ * Count a packet transmission.
+ * \param [in] packet The packet.
+ */
+void
+CountPacket(Ptr<const Packet> packet)
+{
+    g_packets++;
+}
+
+/**
+ * Draw the rate of the bottleneck, as sim.cc does.
+ * \param [in] device The bottleneck device.
+ * \param [in] rates The distribution of the rate, in Mb/s.
+ */
+void
+UpdateDataRate(Ptr<PointToPointNetDevice> device, Ptr<LogNormalRandomVariable> rates)
+{
+    double sample = std::max(rates->GetValue(), 2.0);
+    device->SetDataRate(DataRate(static_cast<uint64_t>(sample * 1e6)));
+}
+
+/**
+ * \param [in] cc The congestion control name.
+ * \returns The TypeId name of the congestion control.
+ */
+std::string
+GetSocketType(const std::string& cc)
+{
+    if (cc == "aurora-stub")
+    {
+        return "ns3::BenchAuroraStub";
+    }
+    else if (cc == "newreno")
+    {
+        return "ns3::TcpNewReno";
+    }
+    else if (cc == "cubic")
+    {
+        return "ns3::TcpCubic";
+    }
+    else if (cc == "bbr")
+    {
+        return "ns3::TcpBbr";
+    }
+    NS_FATAL_ERROR("Unknown congestion control " << cc);
+    return "";
+}
+
+/**
+ * Run a configuration.
+ * \param [in] cc The congestion control.
+ * \param [in] flows The number of flows.
+ * \param [in] duration The simulated duration.
+ * \returns The result.
+ */
+Result
+Run(std::string cc, uint32_t flows, Time duration)
+{
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue(GetSocketType(cc)));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(2500000));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(5000000));
+    Config::SetDefault("ns3::TcpSocket::DelAckCount", UintegerValue(2));
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocketState::EnablePacing",
+                       BooleanValue(cc == "aurora-stub" || cc == "bbr"));
+
+    PointToPointHelper accessLink;
+    accessLink.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    accessLink.SetChannelAttribute("Delay", StringValue("0.1ms"));
+    PointToPointHelper bottleneckLink;
+    bottleneckLink.SetDeviceAttribute("DataRate", StringValue("12Mbps"));
+    bottleneckLink.SetChannelAttribute("Delay", StringValue("30ms"));
+    bottleneckLink.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("128p"));
+    PointToPointDumbbellHelper dumbbell(flows, accessLink, flows, accessLink, bottleneckLink);
+
+    InternetStackHelper internet;
+    dumbbell.InstallStack(internet);
+    dumbbell.AssignIpv4Addresses(Ipv4AddressHelper("10.1.0.0", "255.255.255.0"),
+                                 Ipv4AddressHelper("10.2.0.0", "255.255.255.0"),
+                                 Ipv4AddressHelper("10.3.0.0", "255.255.255.0"));
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    uint16_t port = 1337;
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    for (uint32_t i = 0; i < flows; i++)
+    {
+        BulkSendHelper source("ns3::TcpSocketFactory",
+                              InetSocketAddress(dumbbell.GetRightIpv4Address(i), port));
+        source.SetAttribute("MaxBytes", UintegerValue(0));
+        ApplicationContainer sourceApps = source.Install(dumbbell.GetLeft(i));
+        sourceApps.Start(MilliSeconds(i));
+        ApplicationContainer sinkApps = sink.Install(dumbbell.GetRight(i));
+        sinkApps.Start(Seconds(0));
+    }
+
+    Ptr<PointToPointNetDevice> bottleneck =
+        DynamicCast<PointToPointNetDevice>(dumbbell.GetLeft()->GetDevice(0));
+    double mean = 12.0;
+    double variance = 10;
+    Ptr<LogNormalRandomVariable> rates = CreateObject<LogNormalRandomVariable>();
+    rates->SetAttribute("Mu", DoubleValue(std::log(mean) - 0.5 * std::log(variance / mean)));
+    rates->SetAttribute("Sigma", DoubleValue(std::sqrt(std::log(1 + variance / (mean * mean)))));
+    rates->SetStream(1);
+    for (Time t = Seconds(1); t < duration; t += Seconds(1))
+    {
+        Simulator::Schedule(t, &UpdateDataRate, bottleneck, rates);
+    }
+
+    g_packets = 0;
+    Config::ConnectWithoutContext("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/PhyTxEnd",
+                                  MakeCallback(&CountPacket));
+
+    Simulator::Stop(duration);
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto end = std::chrono::steady_clock::now();
+
+    Result result;
+    result.cc = cc;
+    result.flows = flows;
+    result.events = Simulator::GetEventCount();
+    result.wall = std::chrono::duration<double>(end - start).count();
+    result.packets = g_packets;
+    result.peakRss = 0;
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        result.peakRss = usage.ru_maxrss;
+    }
+#endif
+    Simulator::Destroy();
+    return result;
+}
+
+/**
+ * Format a result as a JSON object.
+ * \param [in] result The result.
+ * \param [in] duration The simulated duration.
+ * \returns The JSON object.
+ */
+std::string
+ToJson(const Result& result, Time duration)
+{
+    std::ostringstream oss;
+    oss.precision(6);
+    oss << "{ \"cc\": \"" << result.cc << "\", \"flows\": " << result.flows
+        << ", \"events\": " << result.events << ", \"wall_s\": " << result.wall
+        << ", \"events_per_s\": " << (result.wall > 0 ? result.events / result.wall : 0)
+        << ", \"sim_s_per_wall_s\": "
+        << (result.wall > 0 ? duration.GetSeconds() / result.wall : 0)
+        << ", \"packets\": " << result.packets << ", \"ns_per_packet\": "
+        << (result.packets > 0 ? 1e9 * result.wall / result.packets : 0)
+        << ", \"peak_rss_kb\": " << result.peakRss << " }";
+    return oss.str();
+}
+
+/**
+ * Run a configuration in a new instance of this program, so that its peak
+ * RSS is its own, or in this process if the instance cannot be started.
+ * \param [in] program The path of this program.
+ * \param [in] cc The congestion control.
+ * \param [in] flows The number of flows.
+ * \param [in] duration The simulated duration.
+ * \returns The result as a JSON object.
+ */
+std::string
+RunIsolated(const std::string& program, std::string cc, uint32_t flows, Time duration)
+{
+#ifndef _WIN32
+    std::vector<std::string> args{program,
+                                  "--single",
+                                  "--cc=" + cc,
+                                  "--flows=" + std::to_string(flows),
+                                  "--duration=" + std::to_string(duration.GetSeconds())};
+    std::vector<char*> argv;
+    for (auto& arg : args)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    int fds[2];
+    if (pipe(fds) == 0)
+    {
+        // The child execs right away: a forked copy would start from the
+        // peak RSS of this process
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+            if (dup2(fds[1], STDOUT_FILENO) >= 0)
+            {
+                execv(program.c_str(), argv.data());
+            }
+            _exit(127);
+        }
+        close(fds[1]);
+        if (pid < 0)
+        {
+            close(fds[0]);
+            std::cerr << "Cannot fork, running in this process" << std::endl;
+            return ToJson(Run(cc, flows, duration), duration);
+        }
+        std::string json;
+        char buffer[512];
+        ssize_t n;
+        while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+        {
+            json.append(buffer, n);
+        }
+        close(fds[0]);
+        int status;
+        waitpid(pid, &status, 0);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 127 && json.empty())
+        {
+            std::cerr << "Cannot run " << program << ", running in this process" << std::endl;
+            return ToJson(Run(cc, flows, duration), duration);
+        }
+        NS_ABORT_MSG_UNLESS(WIFEXITED(status) && WEXITSTATUS(status) == 0 && !json.empty(),
+                            "Run of " << cc << " with " << flows << " flows failed");
+        while (!json.empty() && json.back() == '\n')
+        {
+            json.pop_back();
+        }
+        return json;
+    }
+#endif
+    return ToJson(Run(cc, flows, duration), duration);
+}
+
+/**
+ * Split a comma-separated list.
+ * \param [in] list The list.
+ * \returns The items.
+ */
+std::vector<std::string>
+Split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream iss(list);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string ccs = "aurora-stub,newreno,cubic,bbr";
+    std::string flows = "1,10,100";
+    double duration = 10;
+    std::string output;
+    bool single = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Simulation throughput benchmark of the DRL congestion control workload.");
+    cmd.AddValue("cc", "comma-separated congestion controls: aurora-stub, newreno, cubic, bbr", ccs);
+    cmd.AddValue("flows", "comma-separated numbers of flows", flows);
+    cmd.AddValue("duration", "simulated time of each run, in seconds", duration);
+    cmd.AddValue("json", "output file (default: standard output)", output);
+    cmd.AddValue("single", "run one configuration in this process (used internally)", single);
+    cmd.Parse(argc, argv);
+
+    if (single)
+    {
+        std::cout << ToJson(Run(ccs, std::stoul(flows), Seconds(duration)), Seconds(duration))
+                  << std::endl;
+        return 0;
+    }
+
+    // The program itself, to run each configuration in a fresh process
+    std::string program =
+        SystemPath::FindSelfDirectory() + "/" + SystemPath::Split(argv[0]).back();
+
+    std::ostringstream oss;
+    oss << "{\n  \"benchmark\": \"bench-drl-cc\",\n  \"duration\": " << duration
+        << ",\n  \"results\": [";
+    bool first = true;
+    for (const auto& cc : Split(ccs))
+    {
+        GetSocketType(cc);
+        for (const auto& n : Split(flows))
+        {
+            std::cerr << "Running " << cc << " with " << n << " flows" << std::endl;
+            oss << (first ? "\n    " : ",\n    ")
+                << RunIsolated(program, cc, std::stoul(n), Seconds(duration));
+            first = false;
+        }
+    }
+    oss << "\n  ]\n}\n";
+
+    if (output.empty())
+    {
+        std::cout << oss.str();
+    }
+    else
+    {
+        std::ofstream file(output);
+        NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open " << output);
+        file << oss.str();
+    }
+    return 0;
+}
@@ -24,11 +24,14 @@
 #include "ns3/command-line.h"
 #include "ns3/packet-metadata.h"
 #include "ns3/packet.h"
+#include "ns3/queue.h"
+#include "ns3/ring-buffer.h"
 #include "ns3/system-wall-clock-ms.h"
 
 #include <algorithm>
 #include <iostream>
 #include <limits>
+#include <list>
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
@@ -332,6 +335,27 @@ benchFragment(uint32_t n)
     }
 }
 
+/**
+ * Build segments as a TCP sender of a bulk transfer does: the payload of
+ * each segment is a concatenation of fragments of the (zero-filled)
+ * chunks written by the application.
+ * \param n The number of segments.
+ */
+static void
+benchBulkSegments(uint32_t n)
+{
+    BenchHeader<20> tcp;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> chunk0 = Create<Packet>(1000);
+        Ptr<Packet> chunk1 = Create<Packet>(1000);
+        Ptr<Packet> segment = chunk0->CreateFragment(500, 500);
+        segment->AddAtEnd(chunk1->CreateFragment(0, 948));
+        segment->AddHeader(tcp);
+    }
+}
+
 static void
 benchByteTags(uint32_t n)
 {
@@ -350,6 +374,84 @@ benchByteTags(uint32_t n)
     }
 }
 
+/// FIFO packet queue stored in a given container, used to compare the containers
+template <typename Container>
+class BenchQueue : public Queue<Packet, Container>
+{
+  public:
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId(std::is_same_v<Container, std::list<Ptr<Packet>>> ? "anon::BenchQueue<list>"
+                                                                    : "anon::BenchQueue<ring>")
+                .SetParent<Queue<Packet, Container>>()
+                .SetGroupName("Utils")
+                .HideFromDocumentation();
+        return tid;
+    }
+
+    bool Enqueue(Ptr<Packet> item) override
+    {
+        return this->DoEnqueue(this->GetContainer().end(), item);
+    }
+
+    Ptr<Packet> Dequeue() override
+    {
+        return this->DoDequeue(this->GetContainer().begin());
+    }
+
+    Ptr<Packet> Remove() override
+    {
+        return this->DoRemove(this->GetContainer().begin());
+    }
+
+    Ptr<const Packet> Peek() const override
+    {
+        return this->DoPeek(this->GetContainer().begin());
+    }
+};
+
+namespace ns3
+{
+
+/**
+ * Name of the Queue stored in a std::list, used by the baseline of benchQueue.
+ * \returns The name.
+ */
+template <>
+std::string
+DoGetTemplateClassName<Queue<Packet, std::list<Ptr<Packet>>>>()
+{
+    return "ns3::Queue<Packet,std::list>";
+}
+
+} // namespace ns3
+
+/**
+ * Move packets through a queue holding 128 packets, as the bottleneck
+ * queue of a saturated link does.
+ * \param n The number of packets.
+ */
+template <typename Container>
+static void
+benchQueue(uint32_t n)
+{
+    Ptr<BenchQueue<Container>> queue = CreateObject<BenchQueue<Container>>();
+    queue->SetMaxSize(QueueSize("128p"));
+    for (uint32_t i = 0; i < 128; i++)
+    {
+        queue->Enqueue(Create<Packet>(1500));
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue->Enqueue(queue->Dequeue());
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -406,7 +508,16 @@ main(int argc, char* argv[])
     runBench(&benchC, n, minIterations, "Remove by func call");
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
+    runBench(&benchBulkSegments, n, minIterations, "Segments of zero-filled chunks");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchQueue<std::list<Ptr<Packet>>>,
+             n,
+             minIterations,
+             "FIFO queue in a std::list (former default)");
+    runBench(&benchQueue<RingBuffer<Ptr<Packet>>>,
+             n,
+             minIterations,
+             "FIFO queue in a RingBuffer (default)");
 
     return 0;
 }
@@ -20,14 +20,56 @@
 #include "ns3/core-module.h"
 
 #include <cmath> // sqrt
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <new>
 #include <string.h>
 #include <vector>
 
 using namespace ns3;
 
+/** Number of calls to the global operator new. */
+uint64_t g_allocs = 0;
+
+/**
+ * Replacement of the global operator new, counting the allocations.
+ * \param [in] size The size of the allocation.
+ * \returns The memory block.
+ */
+void*
+operator new(std::size_t size)
+{
+    ++g_allocs;
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/**
+ * Replacement of the global operator delete, matching operator new.
+ * \param [in] p The memory block.
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Replacement of the global sized operator delete, matching operator new.
+ * \param [in] p The memory block.
+ */
+void
+operator delete(void* p, std::size_t /* size */) noexcept
+{
+    std::free(p);
+}
+
 /** Flag to write debugging output. */
 bool g_debug = false;
 
@@ -81,6 +123,16 @@ class Bench
         m_rand = stream;
     }
 
+    /**
+     * Set the scheduler to use in each run.
+     *
+     * \param [in] factory Factory pre-configured to create the desired Scheduler.
+     */
+    void SetScheduler(const ObjectFactory& factory)
+    {
+        m_factory = factory;
+    }
+
     /**
      * Set the number of events to populate the scheduler with.
      * Each event executed schedules a new event, maintaining the population.
@@ -107,6 +159,7 @@ class Bench
         double simu;     /**< Time (s) for simulation. */
         uint64_t pop;    /**< Event population. */
         uint64_t events; /**< Number of events executed. */
+        uint64_t allocs; /**< Number of allocations during the simulation. */
     };
 
     /**
@@ -123,6 +176,7 @@ class Bench
      */
     void Cb();
 
+    ObjectFactory m_factory;          /**< Factory for the scheduler. */
     Ptr<RandomVariableStream> m_rand; /**< Stream for event delays. */
     uint64_t m_population;            /**< Event population size. */
     uint64_t m_total;                 /**< Total number of events to execute. */
@@ -139,6 +193,8 @@ Bench::Run()
 
     DEB("initializing");
     m_count = 0;
+    // Simulator::Destroy() at the end of the previous run dropped the scheduler
+    Simulator::SetScheduler(m_factory);
 
     timer.Start();
     for (uint64_t i = 0; i < m_population; ++i)
@@ -150,14 +206,16 @@ Bench::Run()
     DEB("initialization took " << init << "s");
 
     DEB("running");
+    uint64_t allocs = g_allocs;
     timer.Start();
     Simulator::Run();
     simu = timer.End() / 1000.0;
+    allocs = g_allocs - allocs;
     DEB("run took " << simu << "s");
 
     Simulator::Destroy();
 
-    return Result{init, simu, m_population, m_count};
+    return Result{init, simu, m_population, m_count, allocs};
 }
 
 void
@@ -221,6 +279,7 @@ class BenchSuite
     {
         PhaseResult init; /**< Initialization phase results. */
         PhaseResult run;  /**< Run (simulation) phase results. */
+        double allocs;    /**< Run phase allocations per event. */
         /**
          * Construct from the individual run result.
          *
@@ -249,7 +308,8 @@ BenchSuite::Result
 BenchSuite::Result::Bench(Bench::Result r)
 {
     return Result{{r.init, r.pop / r.init, r.init / r.pop},
-                  {r.simu, r.events / r.simu, r.simu / r.events}};
+                  {r.simu, r.events / r.simu, r.simu / r.events},
+                  static_cast<double>(r.allocs) / r.events};
 }
 
 template <typename T>
@@ -261,7 +321,7 @@ BenchSuite::Result::Log(T label) const
     LOG(std::left << std::setw(g_fwidth) << label << std::setw(g_fwidth) << init.time
                   << std::setw(g_fwidth) << init.rate << std::setw(g_fwidth) << init.period
                   << std::setw(g_fwidth) << run.time << std::setw(g_fwidth) << run.rate
-                  << std::setw(g_fwidth) << run.period);
+                  << std::setw(g_fwidth) << run.period << std::setw(g_fwidth) << allocs);
 }
 
 BenchSuite::BenchSuite(ObjectFactory& factory,
@@ -271,8 +331,6 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
                        Ptr<RandomVariableStream> eventStream,
                        bool calRev)
 {
-    Simulator::SetScheduler(factory);
-
     m_scheduler = factory.GetTypeId().GetName();
     if (m_scheduler == "ns3::CalendarScheduler")
     {
@@ -282,8 +340,10 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     {
         m_scheduler += " (default)";
     }
+    m_scheduler += std::string(", event pool: ") + (EventImpl::IsPoolEnabled() ? "on" : "off");
 
     Bench bench(pop, total);
+    bench.SetScheduler(factory);
     bench.SetRandomStream(eventStream);
     bench.SetPopulation(pop);
     bench.SetTotal(total);
@@ -315,17 +375,19 @@ BenchSuite::Header() const
     LOG("");
     LOG(m_scheduler);
     LOG(std::left << std::setw(g_fwidth) << "Run #" << std::left << std::setw(3 * g_fwidth)
-                  << "Initialization:" << std::left << "Simulation:");
+                  << "Initialization:" << std::left << std::setw(3 * g_fwidth) << "Simulation:"
+                  << std::left << "Memory:");
     LOG(std::left << std::setw(g_fwidth) << "" << std::left << std::setw(g_fwidth) << "Time (s)"
                   << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
                   << std::setw(g_fwidth) << "Per (s/ev)" << std::left << std::setw(g_fwidth)
                   << "Time (s)" << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
-                  << "Per (s/ev)");
+                  << std::setw(g_fwidth) << "Per (s/ev)" << std::left << "Allocs/ev");
     LOG(std::setfill('-') << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
                           << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
-                          << std::right << std::setw(g_fwidth) << " " << std::setfill(' '));
+                          << std::right << std::setw(g_fwidth) << " " << std::right
+                          << std::setw(g_fwidth) << " " << std::setfill(' '));
 }
 
 void
@@ -346,7 +408,8 @@ BenchSuite::Log() const
     uint64_t n{0};                // number of samples
     Result average{m_results[0]}; // average
     Result moment2{{0, 0, 0},     // 2nd moment, to calculate stdev
-                   {0, 0, 0}};
+                   {0, 0, 0},
+                   0};
 
     for (; n < m_results.size(); ++n)
     {
@@ -369,6 +432,11 @@ BenchSuite::Log() const
         ACCUMULATE(run, period);
 
 #undef ACCUMULATE
+
+        deltaPre = run.allocs - average.allocs;
+        average.allocs += deltaPre / count;
+        deltaPost = run.allocs - average.allocs;
+        moment2.allocs += deltaPre * deltaPost;
     }
 
     auto stdev = Result{{std::sqrt(moment2.init.time / n),
@@ -376,7 +444,8 @@ BenchSuite::Log() const
                          std::sqrt(moment2.init.period / n)},
                         {std::sqrt(moment2.run.time / n),
                          std::sqrt(moment2.run.rate / n),
-                         std::sqrt(moment2.run.period / n)}};
+                         std::sqrt(moment2.run.period / n)},
+                        std::sqrt(moment2.allocs / n)};
 
     average.Log("average");
     stdev.Log("stdev");
@@ -455,6 +524,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -464,6 +534,8 @@ main(int argc, char* argv[])
     uint64_t runs = 1;
     std::string filename = "";
     bool calRev = false;
+    bool noPool = false;
+    bool poolCmp = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
@@ -475,11 +547,16 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
-              "If no scheduler is specified the MapScheduler will be run.");
+              "If no scheduler is specified the MapScheduler will be run.\n"
+              "\n"
+              "The number of allocations per event during the simulation phase\n"
+              "is reported for the EventImpl pool, which can be disabled with\n"
+              "--nopool, or compared to the plain allocator with --poolcmp.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarSheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListSheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -489,6 +566,8 @@ main(int argc, char* argv[])
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
+    cmd.AddValue("nopool", "disable the EventImpl pool", noPool);
+    cmd.AddValue("poolcmp", "run each scheduler without and with the EventImpl pool", poolCmp);
     cmd.Parse(argc, argv);
 
     g_me = cmd.GetName() + ": ";
@@ -503,32 +582,51 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
     auto eventStream = GetRandomStream(filename);
 
+    std::vector<bool> poolModes{!noPool};
+    if (poolCmp)
+    {
+        poolModes = {false, true};
+    }
+    // Run a suite for each EventImpl pool mode
+    auto runSuites = [&](ObjectFactory& suiteFactory, uint64_t suiteTotal, bool suiteCalRev) {
+        for (bool pool : poolModes)
+        {
+            EventImpl::SetPoolEnabled(pool);
+            BenchSuite(suiteFactory, pop, suiteTotal, runs, eventStream, suiteCalRev).Log();
+        }
+    };
+
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
     {
         factory.SetTypeId("ns3::CalendarScheduler");
         factory.Set("Reverse", BooleanValue(calRev));
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuites(factory, total, calRev);
         if (allSched)
         {
             factory.Set("Reverse", BooleanValue(!calRev));
-            BenchSuite(factory, pop, total, runs, eventStream, !calRev).Log();
+            runSuites(factory, total, !calRev);
         }
     }
     if (schedHeap)
     {
         factory.SetTypeId("ns3::HeapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuites(factory, total, calRev);
+    }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        runSuites(factory, total, calRev);
     }
     if (schedList)
     {
@@ -539,17 +637,17 @@ main(int argc, char* argv[])
             LOG("Running List scheduler with 1/10 total events");
             listTotal /= 10;
         }
-        BenchSuite(factory, pop, listTotal, runs, eventStream, calRev).Log();
+        runSuites(factory, listTotal, calRev);
     }
     if (schedMap)
     {
         factory.SetTypeId("ns3::MapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuites(factory, total, calRev);
     }
     if (schedPQ)
     {
         factory.SetTypeId("ns3::PriorityQueueScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        runSuites(factory, total, calRev);
     }
 
     return 0;